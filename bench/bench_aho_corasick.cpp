@@ -0,0 +1,116 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <ming/aho_corasick.hpp>
+#include <ming/trie.hpp>
+
+// Log-line-like text with a pattern planted every few lines
+static std::string mklog(std::vector<std::string> const &patterns, std::size_t bytes) {
+  static char const *const levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+  std::mt19937_64 gen(5);
+  std::string text;
+  text.reserve(bytes + 256);
+  for (std::size_t line = 0; text.size() < bytes; ++line) {
+    text += "2026-10-18T12:00:" + std::to_string(10 + gen() % 50) + "Z " +
+            levels[gen() % 4] + " worker-" + std::to_string(gen() % 64) +
+            " request id=" + std::to_string(gen()) + " took " +
+            std::to_string(gen() % 1000) + "ms";
+    if (line % 8 == 0) {
+      text += " " + patterns[gen() % patterns.size()];
+    }
+    text += '\n';
+  }
+  return text;
+}
+
+static std::vector<std::string> mkpatterns(std::size_t n) {
+  std::mt19937_64 gen(6);
+  std::vector<std::string> patterns;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::string p(5 + gen() % 12, '\0');
+    for (auto &c : p) {
+      c = "abcdefghijklmnopqrstuvwxyz_-=0123456789"[gen() % 39];
+    }
+    patterns.push_back(std::move(p));
+  }
+  return patterns;
+}
+
+static void BM_AhoCorasickScan(benchmark::State &state) {
+  auto const patterns = mkpatterns(static_cast<std::size_t>(state.range(0)));
+  ming::Trie<char> trie;
+  for (auto const &p : patterns) {
+    trie.insert(p);
+  }
+  auto const ac = trie.compile();
+  std::string const text = mklog(patterns, 16 << 20);
+
+  std::size_t matches = 0;
+  for (auto _ : state) {
+    matches = ac.count(text);
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+  state.counters["matches"] = static_cast<double>(matches);
+  state.counters["table_bytes"] = static_cast<double>(ac.memory_usage());
+}
+BENCHMARK(BM_AhoCorasickScan)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
+// The approach compile() replaces: walk the trie from every offset of the text
+static void BM_TrieScanEveryOffset(benchmark::State &state) {
+  auto const patterns = mkpatterns(static_cast<std::size_t>(state.range(0)));
+  ming::Trie<char> trie;
+  for (auto const &p : patterns) {
+    trie.insert(p);
+  }
+  std::string const text = mklog(patterns, 1 << 20);
+  std::string_view const view(text);
+
+  std::size_t matches = 0;
+  for (auto _ : state) {
+    matches = 0;
+    for (std::size_t pos = 0; pos < view.size(); ++pos) {
+      for (std::size_t len = 1; pos + len <= view.size(); ++len) {
+        std::string_view const candidate = view.substr(pos, len);
+        if (!trie.starts_with(candidate)) {
+          break;
+        }
+        matches += trie.is_word(candidate);
+      }
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+  state.counters["matches"] = static_cast<double>(matches);
+}
+BENCHMARK(BM_TrieScanEveryOffset)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,138 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <ming/eviction_policy.hpp>
+#include <ming/tiny_lfu.hpp>
+#include <ming/weighted_lru.hpp>
+
+static std::size_t constexpr const UNIVERSE = 100000;
+static std::size_t constexpr const LENGTH = 1 << 21;
+static int constexpr const CAPACITY = 20000;
+
+enum Trace { ZIPF, SCAN_MIXED, LOOP };
+
+static std::vector<std::uint64_t> mkzipf(std::size_t n, std::uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<double> weights(UNIVERSE);
+  for (std::size_t i = 0; i < UNIVERSE; ++i) {
+    weights[i] = 1.0 / std::pow(static_cast<double>(i + 1), 0.9);
+  }
+  std::discrete_distribution<std::uint64_t> zipf(weights.begin(), weights.end());
+  std::vector<std::uint64_t> keys(n);
+  for (auto &key : keys) {
+    key = zipf(gen);
+  }
+  return keys;
+}
+
+// Zipf traffic, with a sequential scan over fresh keys (a batch job, a crawler)
+// spliced in after every 100k requests, each scan twice the cache's capacity long
+static std::vector<std::uint64_t> mkscanmixed() {
+  auto const zipf = mkzipf(LENGTH, 2);
+  std::vector<std::uint64_t> keys;
+  keys.reserve(LENGTH * 3 / 2);
+  std::uint64_t fresh = UNIVERSE;
+  for (std::size_t i = 0; i < zipf.size(); ++i) {
+    keys.push_back(zipf[i]);
+    if (i % 100000 == 99999) {
+      for (int j = 0; j < 2 * CAPACITY; ++j) {
+        keys.push_back(fresh++);
+      }
+    }
+  }
+  return keys;
+}
+
+// A loop over 10000 keys, a little more than fit, which defeats recency alone
+static std::vector<std::uint64_t> mkloop() {
+  std::vector<std::uint64_t> keys(LENGTH);
+  for (std::size_t i = 0; i < LENGTH; ++i) {
+    keys[i] = i % 10000;
+  }
+  return keys;
+}
+
+static std::vector<std::uint64_t> const &trace(Trace t) {
+  static std::vector<std::uint64_t> const zipf = mkzipf(LENGTH, 1);
+  static std::vector<std::uint64_t> const scan_mixed = mkscanmixed();
+  static std::vector<std::uint64_t> const loop = mkloop();
+  switch (t) {
+  case ZIPF:
+    return zipf;
+  case SCAN_MIXED:
+    return scan_mixed;
+  default:
+    return loop;
+  }
+}
+
+// Replay a trace through a cache, filling it on every miss. Entries weigh 1 to 4;
+// the byte hit rate counts the weight of the hits.
+template <typename Cache>
+static void BM_HitRate(benchmark::State &state) {
+  auto const &keys = trace(static_cast<Trace>(state.range(0)));
+  std::size_t hits = 0;
+  std::size_t hit_weight = 0;
+  std::size_t total_weight = 0;
+  for (auto _ : state) {
+    Cache cache(CAPACITY);
+    hits = hit_weight = total_weight = 0;
+    for (std::uint64_t key : keys) {
+      int const size = 1 + static_cast<int>(key % 4);
+      total_weight += static_cast<std::size_t>(size);
+      if (cache.get(key)) {
+        ++hits;
+        hit_weight += static_cast<std::size_t>(size);
+      } else {
+        cache.put(key, key, size);
+      }
+    }
+    benchmark::DoNotOptimize(cache);
+  }
+  state.counters["hit_rate"] =
+      static_cast<double>(hits) / static_cast<double>(keys.size());
+  state.counters["byte_hit_rate"] =
+      static_cast<double>(hit_weight) / static_cast<double>(total_weight);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+}
+
+template <typename Policy>
+using Weighted = ming::WeightedLRU<std::uint64_t, std::uint64_t, Policy>;
+
+#define HIT_RATE_BENCHMARK(...)                                                        \
+  BENCHMARK(BM_HitRate<__VA_ARGS__>)                                                   \
+      ->ArgName("trace")                                                               \
+      ->Arg(ZIPF)                                                                      \
+      ->Arg(SCAN_MIXED)                                                                \
+      ->Arg(LOOP)                                                                      \
+      ->Unit(benchmark::kMillisecond)
+
+HIT_RATE_BENCHMARK(Weighted<ming::LRUPolicy>);
+HIT_RATE_BENCHMARK(Weighted<ming::SLRUPolicy>);
+HIT_RATE_BENCHMARK(Weighted<ming::ARCPolicy>);
+HIT_RATE_BENCHMARK(Weighted<ming::S3FIFOPolicy>);
+HIT_RATE_BENCHMARK(Weighted<ming::GDSFPolicy>);
+HIT_RATE_BENCHMARK(ming::TinyLFU<std::uint64_t, std::uint64_t>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <memory>
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <ming/concurrent_skiplist.hpp>
+
+static std::size_t constexpr const N = 100000;
+
+using map_type = ming::ConcurrentSkipListMap<std::size_t, std::size_t>;
+
+static std::unique_ptr<map_type> g_map;
+
+static void prefill(map_type &map) {
+  for (auto i = 0uz; i < N; i += 2) {
+    map.insert(i, i * 10);
+  }
+}
+
+// 100% lookups over a half-full key space
+static void BM_ConcurrentSkipListFind(benchmark::State &state) {
+  if (state.thread_index() == 0) {
+    g_map = std::make_unique<map_type>();
+    prefill(*g_map);
+  }
+
+  std::mt19937_64 gen(123 + state.thread_index());
+  std::uniform_int_distribution<std::size_t> dist(0, N - 1);
+
+  for (auto _ : state) {
+    auto found = g_map->contains(dist(gen));
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    g_map.reset();
+  }
+}
+BENCHMARK(BM_ConcurrentSkipListFind)->ThreadRange(1, 16)->UseRealTime();
+
+// 80% lookups, 10% inserts, 10% erases
+static void BM_ConcurrentSkipListMixed(benchmark::State &state) {
+  if (state.thread_index() == 0) {
+    g_map = std::make_unique<map_type>();
+    prefill(*g_map);
+  }
+
+  std::mt19937_64 gen(321 + state.thread_index());
+  std::uniform_int_distribution<std::size_t> dist(0, N - 1);
+  std::uniform_int_distribution<int> op(0, 9);
+
+  for (auto _ : state) {
+    std::size_t key = dist(gen);
+    switch (op(gen)) {
+    case 0:
+      benchmark::DoNotOptimize(g_map->insert(key, key));
+      break;
+    case 1:
+      benchmark::DoNotOptimize(g_map->erase(key));
+      break;
+    default:
+      benchmark::DoNotOptimize(g_map->contains(key));
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    g_map.reset();
+  }
+}
+BENCHMARK(BM_ConcurrentSkipListMixed)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <ming/concurrent_trie.hpp>
+#include <ming/trie_map.hpp>
+
+static std::size_t constexpr const N = 100000;
+
+static std::vector<std::string> const &routes() {
+  static std::vector<std::string> const keys = [] {
+    std::vector<std::string> k;
+    for (std::size_t i = 0; i < N; ++i) {
+      k.push_back("/svc" + std::to_string(i % 97) + "/route/" + std::to_string(i));
+    }
+    return k;
+  }();
+  return keys;
+}
+
+// The baseline: a single-threaded trie behind a reader-writer lock
+struct LockedTrie {
+  ming::TrieMap<char> map;
+  mutable std::shared_mutex mutex;
+
+  bool insert(std::string const &key) {
+    std::unique_lock lock(mutex);
+    return map.insert_or_assign(key, 1).second;
+  }
+
+  bool erase(std::string const &key) {
+    std::unique_lock lock(mutex);
+    return map.erase(key);
+  }
+
+  bool is_word(std::string const &key) const {
+    std::shared_lock lock(mutex);
+    return map.contains(key);
+  }
+};
+
+template <typename Table>
+struct Fixture {
+  Table table;
+  std::atomic<bool> stop{false};
+  std::atomic<std::size_t> updates{0};
+  std::thread writer;
+
+  Fixture() {
+    for (auto const &key : routes()) {
+      table.insert(key);
+    }
+    // One writer churning its own keys for as long as the readers run
+    writer = std::thread([this] {
+      std::size_t i = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        std::string const key = "/churn/" + std::to_string(i++ % 64);
+        table.insert(key);
+        table.erase(key);
+        updates.fetch_add(2, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  ~Fixture() {
+    stop = true;
+    writer.join();
+  }
+};
+
+template <typename Table>
+static std::unique_ptr<Fixture<Table>> g_fixture;
+
+// Read throughput per reader thread while one writer updates continuously
+template <typename Table>
+static void BM_ReadUnderWrites(benchmark::State &state) {
+  if (state.thread_index() == 0) {
+    g_fixture<Table> = std::make_unique<Fixture<Table>>();
+  }
+
+  auto const &keys = routes();
+  std::mt19937_64 gen(123 + state.thread_index());
+  std::uniform_int_distribution<std::size_t> dist(0, N - 1);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(g_fixture<Table>->table.is_word(keys[dist(gen)]));
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    state.counters["updates"] = static_cast<double>(g_fixture<Table>->updates.load());
+    g_fixture<Table>.reset();
+    ming::EpochReclaimer::instance().synchronize();
+  }
+}
+BENCHMARK(BM_ReadUnderWrites<ming::ConcurrentTrie>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK(BM_ReadUnderWrites<LockedTrie>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
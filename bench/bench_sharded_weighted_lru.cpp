@@ -0,0 +1,108 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <ming/sharded_weighted_lru.hpp>
+#include <ming/weighted_lru.hpp>
+
+static std::size_t constexpr const UNIVERSE = 200000;
+static int constexpr const CAPACITY = 400000;
+
+// The baseline: one WeightedLRU behind one mutex, as every get() reorders it
+struct LockedLRU {
+  ming::WeightedLRU<std::uint64_t, std::uint64_t> cache{CAPACITY};
+  std::mutex mutex;
+
+  std::expected<std::uint64_t, std::string> get(std::uint64_t key) {
+    std::lock_guard lock(mutex);
+    return cache.get(key);
+  }
+
+  void put(std::uint64_t key, std::uint64_t value, int size) {
+    std::lock_guard lock(mutex);
+    cache.put(key, value, size);
+  }
+};
+
+struct ShardedLRU : ming::ShardedWeightedLRU<std::uint64_t, std::uint64_t> {
+  ShardedLRU() : ShardedWeightedLRU(CAPACITY, 64) {}
+};
+
+// Zipf-distributed keys, shared by all threads
+static std::vector<std::uint64_t> const &trace() {
+  static std::vector<std::uint64_t> const keys = [] {
+    std::mt19937_64 gen(5);
+    std::vector<double> weights(UNIVERSE);
+    for (std::size_t i = 0; i < UNIVERSE; ++i) {
+      weights[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    std::discrete_distribution<std::uint64_t> zipf(weights.begin(), weights.end());
+    std::vector<std::uint64_t> k(1 << 20);
+    for (auto &key : k) {
+      key = zipf(gen);
+    }
+    return k;
+  }();
+  return keys;
+}
+
+template <typename Cache>
+static std::unique_ptr<Cache> g_cache;
+
+// A read-mostly cache tier: each thread issues gets, and fills on a miss
+template <typename Cache>
+static void BM_ConcurrentCache(benchmark::State &state) {
+  auto const &keys = trace();
+  if (state.thread_index() == 0) {
+    g_cache<Cache> = std::make_unique<Cache>();
+    for (std::uint64_t i = 0; i < UNIVERSE; ++i) {
+      g_cache<Cache>->put(i, i, 1 + static_cast<int>(i % 4));
+    }
+  }
+
+  std::size_t i = static_cast<std::size_t>(state.thread_index()) * 7919;
+  std::size_t hits = 0;
+  for (auto _ : state) {
+    std::uint64_t const key = keys[i++ & (keys.size() - 1)];
+    if (g_cache<Cache>->get(key)) {
+      ++hits;
+    } else {
+      g_cache<Cache>->put(key, key, 1 + static_cast<int>(key % 4));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["hit_rate"] = benchmark::Counter(
+      static_cast<double>(hits) / static_cast<double>(state.iterations()),
+      benchmark::Counter::kAvgThreads);
+
+  if (state.thread_index() == 0) {
+    g_cache<Cache>.reset();
+  }
+}
+BENCHMARK(BM_ConcurrentCache<ShardedLRU>)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ConcurrentCache<LockedLRU>)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -18,6 +18,10 @@
 
 #define SUPPRESS_UNUSED _Pragma("GCC diagnostic ignored \"-Wunused-variable\"")
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 #include <ming/skiplist.hpp>
 
@@ -36,6 +40,39 @@ static void BM_SkipListInsert(benchmark::State &state) {
 }
 BENCHMARK(BM_SkipListInsert);
 
+static void BM_SkipListFromSorted(benchmark::State &state) {
+  std::vector<std::pair<std::size_t, std::size_t>> input;
+  input.reserve(N);
+  for (auto i = 0uz; i < N; ++i) {
+    input.emplace_back(i, i * 10);
+  }
+
+  for (auto _ : state) {
+    auto sl = ming::SkipList<std::size_t, std::size_t>::from_sorted(input);
+    benchmark::DoNotOptimize(sl);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_SkipListFromSorted);
+
+static void BM_SkipListMerge(benchmark::State &state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    ming::SkipList<std::size_t, std::size_t> evens;
+    ming::SkipList<std::size_t, std::size_t> odds;
+    for (auto i = 0uz; i < N; i += 2) {
+      evens.insert(i, i);
+      odds.insert(i + 1, i + 1);
+    }
+    state.ResumeTiming();
+
+    evens.merge(odds);
+    benchmark::DoNotOptimize(evens);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_SkipListMerge);
+
 static void BM_SkipListSearch(benchmark::State &state) {
   ming::SkipList<std::size_t, std::size_t> sl;
   for (auto i = 0uz; i < N; ++i) {
@@ -74,4 +111,151 @@ static void BM_SkipListErase(benchmark::State &state) {
 }
 BENCHMARK(BM_SkipListErase);
 
+static void BM_SkipListContains(benchmark::State &state) {
+  ming::SkipList<std::string, std::string> sl;
+  for (auto i = 0uz; i < N; ++i) {
+    sl.insert(std::to_string(i), std::string(64, 'v'));
+  }
+
+  std::mt19937_64 gen(123);
+  std::uniform_int_distribution<std::size_t> dist(0, 2 * N - 1);
+  std::vector<std::string> probes(N);
+  for (auto &p : probes) {
+    p = std::to_string(dist(gen));
+  }
+
+  for (auto _ : state) {
+    std::size_t hits = 0;
+    for (auto const &p : probes) {
+      hits += sl.contains(p);
+    }
+    benchmark::DoNotOptimize(hits);
+  }
+}
+BENCHMARK(BM_SkipListContains);
+
+// Steady-state churn: one insert and one erase per key, so only the node
+// allocation itself remains on the write path
+static void BM_SkipListInsertEraseChurn(benchmark::State &state) {
+  ming::SkipList<std::size_t, std::size_t> sl;
+  for (auto i = 0uz; i < N; i += 2) {
+    sl.insert(i, i);
+  }
+
+  std::mt19937_64 gen(123);
+  std::uniform_int_distribution<std::size_t> dist(0, N / 2 - 1);
+
+  for (auto _ : state) {
+    std::size_t key = dist(gen) * 2 + 1;
+    sl.insert(key, key);
+    sl.erase(key);
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_SkipListInsertEraseChurn);
+
+static void BM_SkipListTryEmplaceMove(benchmark::State &state) {
+  std::vector<std::string> keys(N);
+  for (auto i = 0uz; i < N; ++i) {
+    keys[i] = "key/" + std::to_string(i) + "/with/a/long/enough/suffix";
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    ming::SkipList<std::string, std::string> sl;
+    auto batch = keys;
+    state.ResumeTiming();
+
+    for (auto &k : batch) {
+      sl.try_emplace(std::move(k), 64, 'v');
+    }
+    benchmark::DoNotOptimize(sl);
+
+    state.PauseTiming();
+    sl.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(N));
+}
+BENCHMARK(BM_SkipListTryEmplaceMove);
+
+// Random point lookups on large lists, where the search path is dominated by
+// cache misses rather than comparisons
+static void BM_SkipListRandomLookup(benchmark::State &state) {
+  auto const n = static_cast<std::size_t>(state.range(0));
+  std::vector<std::pair<std::size_t, std::size_t>> input;
+  input.reserve(n);
+  for (auto i = 0uz; i < n; ++i) {
+    input.emplace_back(i * 2, i);
+  }
+  auto sl = ming::SkipList<std::size_t, std::size_t>::from_sorted(input);
+  input = {};
+
+  std::mt19937_64 gen(123);
+  std::uniform_int_distribution<std::size_t> dist(0, 2 * n - 1);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sl.contains(dist(gen)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SkipListRandomLookup)->Arg(1 << 16)->Arg(1 << 20)->Arg(10'000'000);
+
+// Insert cost and search depth against the branching probability 1/range(0), with
+// a fixed seed so runs are reproducible
+static void BM_SkipListInsertProbability(benchmark::State &state) {
+  ming::SkipListOptions options;
+  options.probability = 1.0 / static_cast<double>(state.range(0));
+  options.seed = 123;
+
+  for (auto _ : state) {
+    ming::SkipList<std::size_t, std::size_t> sl(options);
+    for (auto i = 0uz; i < N; ++i) {
+      sl.insert((i * 2654435761u) % N, i);
+    }
+    benchmark::DoNotOptimize(sl.size());
+    state.counters["levels"] = sl.level();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(N));
+}
+BENCHMARK(BM_SkipListInsertProbability)->Arg(2)->Arg(4)->Arg(8);
+
+static void BM_SkipListAtRank(benchmark::State &state) {
+  ming::SkipList<std::size_t, std::size_t> sl;
+  for (auto i = 0uz; i < N; ++i) {
+    sl.insert(i, i * 10);
+  }
+
+  std::mt19937_64 gen(123);
+  std::uniform_int_distribution<std::size_t> dist(0, N - 1);
+
+  for (auto _ : state) {
+    auto it = sl.at_rank(dist(gen));
+    benchmark::DoNotOptimize(it);
+  }
+}
+BENCHMARK(BM_SkipListAtRank);
+
+static void BM_SkipListRangeScan(benchmark::State &state) {
+  ming::SkipList<std::size_t, std::size_t> sl;
+  for (auto i = 0uz; i < N; ++i) {
+    sl.insert(i, i * 10);
+  }
+
+  auto const window = static_cast<std::size_t>(state.range(0));
+  std::mt19937_64 gen(123);
+  std::uniform_int_distribution<std::size_t> dist(0, N - window);
+
+  for (auto _ : state) {
+    std::size_t lo = dist(gen);
+    std::size_t sum = 0;
+    for (auto [key, value] : sl.range(lo, lo + window)) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(window));
+}
+BENCHMARK(BM_SkipListRangeScan)->Arg(16)->Arg(256)->Arg(4096);
+
 BENCHMARK_MAIN();
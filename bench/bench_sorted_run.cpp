@@ -0,0 +1,97 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <ming/skiplist.hpp>
+#include <ming/sorted_run.hpp>
+
+static std::size_t constexpr const N = 100000;
+
+using run_type = ming::SortedRun<std::size_t, std::string>;
+
+static std::filesystem::path run_path() {
+  return std::filesystem::temp_directory_path() / "ming_bench_sorted_run";
+}
+
+static run_type make_run(std::size_t bloom_bits_per_key) {
+  ming::SkipList<std::size_t, std::string> memtable;
+  for (auto i = 0uz; i < N; ++i) {
+    memtable.insert(i * 2, std::string(32, 'v'));
+  }
+  ming::SortedRunOptions options;
+  options.bloom_bits_per_key = bloom_bits_per_key;
+  return run_type::write(run_path(), memtable, options);
+}
+
+static void BM_SortedRunFlush(benchmark::State &state) {
+  ming::SkipList<std::size_t, std::string> memtable;
+  for (auto i = 0uz; i < N; ++i) {
+    memtable.insert(i * 2, std::string(32, 'v'));
+  }
+
+  for (auto _ : state) {
+    auto run = run_type::write(run_path(), memtable);
+    benchmark::DoNotOptimize(run.size());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(N));
+  std::filesystem::remove(run_path());
+}
+BENCHMARK(BM_SortedRunFlush);
+
+// range(0) selects hits (0) or misses (1); range(1) is the bloom budget per key
+static void BM_SortedRunFind(benchmark::State &state) {
+  auto run = make_run(static_cast<std::size_t>(state.range(1)));
+  std::size_t const miss = static_cast<std::size_t>(state.range(0));
+
+  std::mt19937_64 gen(123);
+  std::uniform_int_distribution<std::size_t> dist(0, N - 1);
+
+  for (auto _ : state) {
+    auto value = run.find(dist(gen) * 2 + miss);
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations());
+  std::filesystem::remove(run_path());
+}
+BENCHMARK(BM_SortedRunFind)->Args({0, 10})->Args({1, 10})->Args({1, 0});
+
+static void BM_SortedRunRangeScan(benchmark::State &state) {
+  auto run = make_run(10);
+  auto const window = static_cast<std::size_t>(state.range(0));
+
+  std::mt19937_64 gen(123);
+  std::uniform_int_distribution<std::size_t> dist(0, 2 * (N - window));
+
+  for (auto _ : state) {
+    std::size_t lo = dist(gen);
+    std::size_t bytes = 0;
+    for (auto const &[key, value] : run.range(lo, lo + 2 * window)) {
+      bytes += value.size();
+    }
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(window));
+  std::filesystem::remove(run_path());
+}
+BENCHMARK(BM_SortedRunRangeScan)->Arg(16)->Arg(4096);
+
+BENCHMARK_MAIN();
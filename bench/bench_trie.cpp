@@ -16,11 +16,18 @@
 // along with ming.  If not, see <https://www.gnu.org/licenses/>.
 //
 
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <memory>
 #include <random>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <benchmark/benchmark.h>
+#include <ming/radix_trie.hpp>
 #include <ming/trie.hpp>
 
 static std::string mkstr(std::size_t i) {
@@ -30,47 +37,380 @@ static std::string mkstr(std::size_t i) {
 }
 
 static void BM_TrieInsert(benchmark::State &state) {
-  std::size_t const N = 100000;
+  auto const n = static_cast<std::size_t>(state.range(0));
 
-  ming::Trie<char> trie;
   std::vector<std::string> keys;
-  keys.reserve(N);
+  keys.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    keys.push_back(mkstr(i));
+  }
 
   for (auto _ : state) {
-    for (std::size_t i = 0; i < N; ++i) {
-      keys.push_back(mkstr(i));
+    ming::Trie<char> trie;
+    for (auto const &key : keys) {
+      trie.insert(key);
     }
-  }
+    benchmark::DoNotOptimize(trie);
+    benchmark::ClobberMemory();
 
-  benchmark::DoNotOptimize(trie);
-  benchmark::ClobberMemory();
+    state.counters["nodes"] = static_cast<double>(trie.node_count());
+    state.counters["bytes_per_key"] =
+        static_cast<double>(trie.memory_usage()) / static_cast<double>(n);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
 }
 
-BENCHMARK(BM_TrieInsert);
+BENCHMARK(BM_TrieInsert)->Arg(100000)->Arg(1000000);
 
 static void BM_TrieFind(benchmark::State &state) {
-  std::size_t const N = 100000;
+  auto const n = static_cast<std::size_t>(state.range(0));
 
   ming::Trie<char> trie;
   std::vector<std::string> keys;
-  keys.reserve(N);
-  for (std::size_t i = 0; i < N; ++i) {
+  keys.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
     keys.push_back(mkstr(i));
+    trie.insert(keys.back());
   }
 
   std::mt19937_64 gen(77);
-  std::uniform_int_distribution<std::size_t> dist(0, N - 1);
+  std::uniform_int_distribution<std::size_t> dist(0, n - 1);
   std::size_t found = 0;
   for (auto _ : state) {
-    for (auto i = 0uz; i < N; ++i) {
-      if (trie.is_word(keys[dist(gen)]))
-        ++found;
+    if (trie.is_word(keys[dist(gen)])) {
+      ++found;
     }
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrieFind)->Arg(100000)->Arg(1000000);
 
-    benchmark::DoNotOptimize(trie);
+static void BM_TrieCopyDestroy(benchmark::State &state) {
+  auto const n = static_cast<std::size_t>(state.range(0));
+
+  ming::Trie<char> trie;
+  for (std::size_t i = 0; i < n; ++i) {
+    trie.insert(mkstr(i));
+  }
+
+  for (auto _ : state) {
+    // copy, then let the copy go out of scope
+    ming::Trie<char> copy(trie);
+    benchmark::DoNotOptimize(copy);
     benchmark::ClobberMemory();
   }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_TrieCopyDestroy)->Arg(100000)->Arg(1000000);
+
+static void BM_LoudsTrieFind(benchmark::State &state) {
+  auto const n = static_cast<std::size_t>(state.range(0));
+
+  ming::Trie<char> trie;
+  std::vector<std::string> keys;
+  keys.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    keys.push_back(mkstr(i));
+    trie.insert(keys.back());
+  }
+  auto const frozen = trie.freeze();
+  trie = {};
+
+  std::mt19937_64 gen(77);
+  std::uniform_int_distribution<std::size_t> dist(0, n - 1);
+  std::size_t found = 0;
+  for (auto _ : state) {
+    if (frozen.is_word(keys[dist(gen)])) {
+      ++found;
+    }
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["bits_per_node"] = static_cast<double>(frozen.memory_usage() * 8) /
+                                    static_cast<double>(frozen.node_count());
+  state.counters["bytes_per_key"] =
+      static_cast<double>(frozen.memory_usage()) / static_cast<double>(n);
+}
+BENCHMARK(BM_LoudsTrieFind)->Arg(100000)->Arg(1000000);
+
+// File-path-like keys: long, with shared directory prefixes and unique tails
+static std::vector<std::string> mkpaths(std::size_t n) {
+  static char const *const dirs[] = {"/usr/share/doc/", "/usr/lib/x86_64-linux-gnu/",
+                                     "/home/user/projects/ming/", "/var/log/journal/"};
+  std::mt19937_64 gen(7);
+  std::vector<std::string> paths;
+  paths.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    paths.push_back(std::string(dirs[gen() % 4]) + "pkg" +
+                    std::to_string(gen() % 5000) + "/file_" + std::to_string(i) +
+                    ".txt");
+  }
+  return paths;
+}
+
+template <typename TrieType>
+static void BM_PathInsert(benchmark::State &state) {
+  auto const paths = mkpaths(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    TrieType trie;
+    for (auto const &path : paths) {
+      trie.insert(path);
+    }
+    benchmark::DoNotOptimize(trie);
+
+    state.counters["nodes"] = static_cast<double>(trie.node_count());
+    state.counters["bytes_per_key"] =
+        static_cast<double>(trie.memory_usage()) / static_cast<double>(paths.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PathInsert<ming::Trie<char>>)->Arg(200000);
+BENCHMARK(BM_PathInsert<ming::RadixTrie>)->Arg(200000);
+
+template <typename TrieType>
+static void BM_PathFind(benchmark::State &state) {
+  auto const paths = mkpaths(static_cast<std::size_t>(state.range(0)));
+  TrieType trie;
+  for (auto const &path : paths) {
+    trie.insert(path);
+  }
+
+  std::mt19937_64 gen(77);
+  std::uniform_int_distribution<std::size_t> dist(0, paths.size() - 1);
+  std::size_t found = 0;
+  for (auto _ : state) {
+    found += trie.is_word(paths[dist(gen)]);
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PathFind<ming::Trie<char>>)->Arg(200000);
+BENCHMARK(BM_PathFind<ming::RadixTrie>)->Arg(200000);
+
+// Multilingual words: each in one script (Latin, Cyrillic, Greek, Arabic, Devanagari,
+// Han), as code points
+static std::vector<std::u32string> mkmultilingual(std::size_t n) {
+  struct Script {
+    char32_t first;
+    char32_t size;
+  };
+  static constexpr Script scripts[] = {{0x61, 26},   {0x430, 32}, {0x3b1, 25},
+                                       {0x627, 36},  {0x915, 37}, {0x4e00, 3000}};
+  std::mt19937_64 gen(314);
+  std::vector<std::u32string> words;
+  words.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    Script const script = scripts[gen() % std::size(scripts)];
+    std::u32string w(2 + gen() % 8, U'\0');
+    for (auto &c : w) {
+      c = script.first + static_cast<char32_t>(std::min(gen() % script.size,
+                                                         gen() % script.size));
+    }
+    words.push_back(std::move(w));
+  }
+  return words;
+}
+
+static std::string to_utf8(std::u32string_view word) {
+  std::string out;
+  for (char32_t c : word) {
+    if (c < 0x80) {
+      out.push_back(static_cast<char>(c));
+    } else if (c < 0x800) {
+      out.push_back(static_cast<char>(0xc0 | (c >> 6)));
+      out.push_back(static_cast<char>(0x80 | (c & 0x3f)));
+    } else {
+      out.push_back(static_cast<char>(0xe0 | (c >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+      out.push_back(static_cast<char>(0x80 | (c & 0x3f)));
+    }
+  }
+  return out;
+}
+
+template <typename TrieType>
+static auto mkkeys(std::size_t n) {
+  auto words = mkmultilingual(n);
+  if constexpr (std::same_as<typename TrieType::string_type, std::u32string>) {
+    return words;
+  } else {
+    std::vector<std::string> keys;
+    keys.reserve(n);
+    for (auto const &w : words) {
+      keys.push_back(to_utf8(w));
+    }
+    return keys;
+  }
+}
+
+template <typename TrieType>
+static void BM_MultilingualInsert(benchmark::State &state) {
+  auto const keys = mkkeys<TrieType>(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    TrieType trie;
+    for (auto const &key : keys) {
+      trie.insert(key);
+    }
+    benchmark::DoNotOptimize(trie);
+
+    state.counters["nodes"] = static_cast<double>(trie.node_count());
+    state.counters["bytes_per_key"] =
+        static_cast<double>(trie.memory_usage()) / static_cast<double>(keys.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MultilingualInsert<ming::Trie<char>>)->Arg(500000);
+BENCHMARK(BM_MultilingualInsert<ming::Trie<char, ming::TrieSplit::nibble>>)
+    ->Arg(500000);
+BENCHMARK(BM_MultilingualInsert<ming::Trie<char32_t>>)->Arg(500000);
+
+template <typename TrieType>
+static void BM_MultilingualFind(benchmark::State &state) {
+  auto const keys = mkkeys<TrieType>(static_cast<std::size_t>(state.range(0)));
+  TrieType trie;
+  for (auto const &key : keys) {
+    trie.insert(key);
+  }
+
+  std::mt19937_64 gen(77);
+  std::uniform_int_distribution<std::size_t> dist(0, keys.size() - 1);
+  std::size_t found = 0;
+  for (auto _ : state) {
+    found += trie.is_word(keys[dist(gen)]);
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MultilingualFind<ming::Trie<char>>)->Arg(500000);
+BENCHMARK(BM_MultilingualFind<ming::Trie<char, ming::TrieSplit::nibble>>)
+    ->Arg(500000);
+BENCHMARK(BM_MultilingualFind<ming::Trie<char32_t>>)->Arg(500000);
+
+static ming::Trie<char> mkscored(std::size_t n) {
+  ming::Trie<char> trie;
+  std::mt19937_64 rng(42);
+  for (std::size_t i = 0; i < n; ++i) {
+    trie.insert(mkstr(i), static_cast<ming::Trie<char>::score_type>(rng() % 1000000));
+  }
+  return trie;
+}
+
+// Search-as-you-type: the 10 best completions of a short prefix
+static void BM_TrieTopK(benchmark::State &state) {
+  auto const trie = mkscored(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(trie.top_k("w1", 10));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_TrieTopK)->Arg(100000)->Arg(1000000);
+
+// The same query answered by enumerating every completion through a bounded heap
+static void BM_TrieTopKScan(benchmark::State &state) {
+  auto const trie = mkscored(static_cast<std::size_t>(state.range(0)));
+  using Entry = std::pair<ming::Trie<char>::score_type, std::string>;
+  for (auto _ : state) {
+    std::vector<Entry> heap;
+    trie.for_each_with_prefix("w1", [&](std::string_view w) {
+      heap.emplace_back(trie.score(w), w);
+      std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+      if (heap.size() > 10) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+        heap.pop_back();
+      }
+    });
+    benchmark::DoNotOptimize(heap);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_TrieTopKScan)->Arg(100000)->Arg(1000000);
+
+// A document-like token stream over a large vocabulary: Zipf-distributed word
+// frequencies, with one token in four a misspelling or unknown word
+static std::vector<std::string> mkvocabulary(std::size_t n) {
+  std::mt19937_64 gen(2024);
+  std::vector<std::string> words;
+  words.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::string w(3 + gen() % 10, '\0');
+    for (auto &c : w) {
+      // Skewed letter frequencies give the dense upper levels of a real lexicon
+      c = static_cast<char>('a' + std::min(gen() % 26, gen() % 26));
+    }
+    words.push_back(std::move(w));
+  }
+  return words;
+}
+
+static std::vector<std::string> mktokens(std::vector<std::string> const &vocabulary,
+                                         std::size_t n) {
+  std::mt19937_64 gen(99);
+  std::vector<double> weights(vocabulary.size());
+  for (std::size_t i = 0; i < weights.size(); ++i) {
+    weights[i] = 1.0 / static_cast<double>(i + 1);
+  }
+  std::discrete_distribution<std::size_t> zipf(weights.begin(), weights.end());
+  std::vector<std::string> tokens;
+  tokens.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::string t = vocabulary[zipf(gen)];
+    if (gen() % 4 == 0) {
+      t[gen() % t.size()] = static_cast<char>('a' + gen() % 26);
+    }
+    tokens.push_back(std::move(t));
+  }
+  return tokens;
+}
+
+struct TokenFixture {
+  ming::Trie<char> trie;
+  std::vector<std::string> tokens;
+  std::vector<std::string_view> views;
+
+  TokenFixture() {
+    auto const vocabulary = mkvocabulary(1000000);
+    for (auto const &w : vocabulary) {
+      trie.insert(w);
+    }
+    tokens = mktokens(vocabulary, 1 << 16);
+    views.assign(tokens.begin(), tokens.end());
+  }
+};
+
+static TokenFixture const &token_fixture() {
+  static TokenFixture const fixture;
+  return fixture;
+}
+
+static void BM_TokenIsWord(benchmark::State &state) {
+  auto const &f = token_fixture();
+  for (auto _ : state) {
+    std::size_t found = 0;
+    for (auto token : f.views) {
+      found += f.trie.is_word(token);
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(f.views.size()));
+}
+BENCHMARK(BM_TokenIsWord);
+
+static void BM_TokenIsWordBatch(benchmark::State &state) {
+  auto const &f = token_fixture();
+  auto out = std::make_unique<bool[]>(f.views.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        f.trie.is_word_batch(f.views, std::span(out.get(), f.views.size())));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(f.views.size()));
 }
-BENCHMARK(BM_TrieFind);
+BENCHMARK(BM_TokenIsWordBatch);
 
 BENCHMARK_MAIN();
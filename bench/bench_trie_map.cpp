@@ -0,0 +1,144 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <ming/trie.hpp>
+#include <ming/trie_map.hpp>
+
+static std::size_t constexpr const N = 200000;
+
+// Route-table-like keys: a few API versions and services, many resources
+static std::vector<std::string> mkroutes() {
+  static char const *const services[] = {"users", "orders", "payments", "search",
+                                         "inventory", "shipping"};
+  std::mt19937_64 gen(11);
+  std::vector<std::string> routes;
+  routes.reserve(N);
+  for (std::size_t i = 0; i < N; ++i) {
+    routes.push_back("/api/v" + std::to_string(1 + gen() % 3) + "/" +
+                     services[gen() % 6] + "/" + std::to_string(gen() % 1000) +
+                     "/item" + std::to_string(i));
+  }
+  return routes;
+}
+
+// The pair TrieMap replaces: a map for the values beside a Trie for prefix queries
+struct MapAndTrie {
+  std::unordered_map<std::string, std::uint32_t> values;
+  ming::Trie<char> trie;
+
+  void insert_or_assign(std::string const &key, std::uint32_t value) {
+    values.insert_or_assign(key, value);
+    trie.insert(key);
+  }
+
+  std::uint32_t const *find(std::string const &key) const {
+    auto it = values.find(key);
+    return it == values.end() ? nullptr : &it->second;
+  }
+
+  // The map's share is estimated: a node per entry with the pair, a next pointer
+  // and the cached hash, the bucket array, and key bytes that outgrew the SSO buffer
+  std::size_t memory_usage() const noexcept {
+    std::size_t bytes =
+        trie.memory_usage() + values.bucket_count() * sizeof(void *) +
+        values.size() * (sizeof(decltype(values)::value_type) + 2 * sizeof(void *));
+    for (auto const &[key, value] : values) {
+      if (key.capacity() > std::string().capacity()) {
+        bytes += key.capacity() + 1;
+      }
+    }
+    return bytes;
+  }
+};
+
+struct TrieMapAdapter {
+  ming::TrieMap<std::uint32_t> map;
+
+  void insert_or_assign(std::string const &key, std::uint32_t value) {
+    map.insert_or_assign(key, value);
+  }
+
+  std::uint32_t const *find(std::string const &key) const { return map.find(key); }
+
+  std::size_t memory_usage() const noexcept { return map.memory_usage(); }
+};
+
+template <typename Table>
+static void BM_RouteBuild(benchmark::State &state) {
+  auto const routes = mkroutes();
+  for (auto _ : state) {
+    Table table;
+    for (std::size_t i = 0; i < routes.size(); ++i) {
+      table.insert_or_assign(routes[i], static_cast<std::uint32_t>(i));
+    }
+    benchmark::DoNotOptimize(table);
+
+    // Including the key strings the map owns
+    state.counters["bytes_per_key"] =
+        static_cast<double>(table.memory_usage()) / static_cast<double>(N);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(N));
+}
+BENCHMARK(BM_RouteBuild<MapAndTrie>)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RouteBuild<TrieMapAdapter>)->Unit(benchmark::kMillisecond);
+
+template <typename Table>
+static void BM_RouteFind(benchmark::State &state) {
+  auto const routes = mkroutes();
+  Table table;
+  for (std::size_t i = 0; i < routes.size(); ++i) {
+    table.insert_or_assign(routes[i], static_cast<std::uint32_t>(i));
+  }
+
+  std::mt19937_64 gen(77);
+  std::uniform_int_distribution<std::size_t> dist(0, N - 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.find(routes[dist(gen)]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RouteFind<MapAndTrie>);
+BENCHMARK(BM_RouteFind<TrieMapAdapter>);
+
+static void BM_TrieMapEraseInsert(benchmark::State &state) {
+  auto const routes = mkroutes();
+  ming::TrieMap<std::uint32_t> map;
+  for (std::size_t i = 0; i < routes.size(); ++i) {
+    map.insert_or_assign(routes[i], static_cast<std::uint32_t>(i));
+  }
+
+  std::mt19937_64 gen(5);
+  std::uniform_int_distribution<std::size_t> dist(0, N - 1);
+  for (auto _ : state) {
+    auto const &key = routes[dist(gen)];
+    map.erase(key);
+    map.insert_or_assign(key, 0);
+  }
+  state.counters["nodes"] = static_cast<double>(map.node_count());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrieMapEraseInsert);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,81 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include <memory>
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include <ming/versioned_skiplist.hpp>
+
+static std::size_t constexpr const N = 100000;
+
+using map_type = ming::VersionedSkipList<std::size_t, std::size_t>;
+
+static std::unique_ptr<map_type> g_map;
+
+// Thread 0 keeps overwriting keys while every other thread reads through a
+// snapshot taken per lookup
+static void BM_VersionedSkipListSnapshotFind(benchmark::State &state) {
+  if (state.thread_index() == 0) {
+    g_map = std::make_unique<map_type>();
+    for (auto i = 0uz; i < N; ++i) {
+      g_map->put(i, i);
+    }
+  }
+
+  std::mt19937_64 gen(123 + state.thread_index());
+  std::uniform_int_distribution<std::size_t> dist(0, N - 1);
+
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      g_map->put(dist(gen), 0);
+    } else {
+      auto value = g_map->snapshot().find(dist(gen));
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    g_map.reset();
+  }
+}
+BENCHMARK(BM_VersionedSkipListSnapshotFind)->ThreadRange(1, 8)->UseRealTime();
+
+// Full in-order scan of a snapshot while older versions accumulate underneath
+static void BM_VersionedSkipListSnapshotScan(benchmark::State &state) {
+  map_type map;
+  auto const overwrites = static_cast<std::size_t>(state.range(0));
+  for (auto round = 0uz; round <= overwrites; ++round) {
+    for (auto i = 0uz; i < N; ++i) {
+      map.put(i, round);
+    }
+  }
+
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (auto [key, value] : map.snapshot()) {
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(N));
+}
+BENCHMARK(BM_VersionedSkipListSnapshotScan)->Arg(0)->Arg(3);
+
+BENCHMARK_MAIN();
@@ -19,8 +19,15 @@
 #define SUPPRESS_UNUSED _Pragma("GCC diagnostic ignored \"-Wunused-but-set-variable\"")
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <list>
+#include <memory>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <benchmark/benchmark.h>
@@ -56,7 +63,176 @@ static void BM_WeightedLRU(benchmark::State &state) {
     benchmark::DoNotOptimize(cache);
     benchmark::ClobberMemory();
   }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(N));
 }
 BENCHMARK(BM_WeightedLRU);
 
+// Hits on 4 KiB values under 24-character keys, the key arriving as a string
+// view (e.g. parsed out of a request). get() copies the value and, before keys
+// were looked up as views, needed a temporary std::string; get_if() does neither.
+template <bool ZERO_COPY>
+static void BM_BlobGet(benchmark::State &state) {
+  std::size_t constexpr N = 1000;
+  ming::WeightedLRU<std::string, std::string> cache(static_cast<int>(N));
+  std::vector<std::string> keys;
+  for (auto i = 0uz; i < N; ++i) {
+    keys.push_back("user:session:" + std::to_string(1000000000 + i) + "x");
+    cache.put(keys.back(), std::string(4096, 'v'), 1);
+  }
+
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    for (std::string_view const key : keys) {
+      if constexpr (ZERO_COPY) {
+        bytes += cache.get_if(key)->size();
+      } else {
+        bytes += cache.get(std::string(key))->size();
+      }
+    }
+  }
+  benchmark::DoNotOptimize(bytes);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(N));
+}
+BENCHMARK(BM_BlobGet<false>);
+BENCHMARK(BM_BlobGet<true>);
+
+// Counts the bytes its containers hold, as WeightedLRU::memory_usage() does
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  std::size_t *bytes;
+
+  explicit CountingAllocator(std::size_t *b) noexcept : bytes(b) {}
+
+  template <typename U>
+  CountingAllocator(CountingAllocator<U> const &other) noexcept : bytes(other.bytes) {}
+
+  T *allocate(std::size_t n) {
+    *bytes += n * sizeof(T);
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    *bytes -= n * sizeof(T);
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(CountingAllocator<U> const &other) const noexcept {
+    return bytes == other.bytes;
+  }
+};
+
+// The previous design, a std::list of entries indexed by a std::unordered_map
+template <typename K, typename V>
+class ListLRU {
+  struct LRUItem {
+    K key;
+    V value;
+    int size;
+  };
+  using list_type = std::list<LRUItem, CountingAllocator<LRUItem>>;
+  using position = std::pair<K const, typename list_type::iterator>;
+  using map_type = std::unordered_map<K, typename list_type::iterator, std::hash<K>,
+                                      std::equal_to<K>, CountingAllocator<position>>;
+
+  int m_capacity, m_current_cap;
+  std::size_t m_bytes{0};
+  list_type m_store{CountingAllocator<LRUItem>(&m_bytes)};
+  map_type m_cache_positions{CountingAllocator<position>(&m_bytes)};
+
+public:
+  explicit ListLRU(int capacity) : m_capacity{capacity}, m_current_cap{} {}
+
+  std::expected<V, std::string> get(K const &key) {
+    auto it = m_cache_positions.find(key);
+    if (it == m_cache_positions.end()) {
+      return std::unexpected{"No such key!"};
+    }
+    m_store.splice(m_store.begin(), m_store, it->second);
+    it->second = m_store.begin();
+    return it->second->value;
+  }
+
+  void put(K key, V value, int size) {
+    auto it = m_cache_positions.find(key);
+    if (it != m_cache_positions.end()) {
+      m_current_cap -= it->second->size;
+      m_store.erase(it->second);
+      m_cache_positions.erase(it);
+    }
+    while (m_current_cap + size > m_capacity) {
+      auto const &last = m_store.back();
+      m_cache_positions.erase(last.key);
+      m_current_cap -= last.size;
+      m_store.pop_back();
+    }
+    m_store.push_front({std::move(key), std::move(value), size});
+    m_cache_positions[m_store.front().key] = m_store.begin();
+    m_current_cap += size;
+  }
+
+  std::size_t size() const noexcept { return m_store.size(); }
+
+  std::size_t memory_usage() const noexcept { return m_bytes; }
+};
+
+// A steady-state cache tier: Zipf-distributed keys over a universe four times
+// what fits, 90% gets, and a put of the key after every miss and every tenth get
+template <typename Cache>
+static void BM_CacheMixed(benchmark::State &state) {
+  std::size_t constexpr UNIVERSE = 400000;
+  std::size_t constexpr OPS = 1 << 20;
+  std::mt19937_64 gen(7);
+  std::vector<double> weights(UNIVERSE);
+  for (std::size_t i = 0; i < UNIVERSE; ++i) {
+    weights[i] = 1.0 / static_cast<double>(i + 1);
+  }
+  std::discrete_distribution<std::uint64_t> zipf(weights.begin(), weights.end());
+  std::vector<std::uint64_t> keys(OPS);
+  for (auto &k : keys) {
+    // Scatter the ranks so hot keys are not adjacent integers
+    k = zipf(gen) * 0x9e3779b97f4a7c15ULL;
+  }
+
+  // Fill the cache, measuring its footprint per entry
+  Cache cache(100000 * 8);
+  for (std::uint64_t i = 0; i < UNIVERSE; ++i) {
+    cache.put(i * 0x9e3779b97f4a7c15ULL, i, 1 + static_cast<int>(i % 15));
+  }
+  state.counters["bytes_per_entry"] = static_cast<double>(cache.memory_usage()) /
+                                      static_cast<double>(cache.size());
+
+  std::size_t hits = 0;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < OPS; ++i) {
+      std::uint64_t const key = keys[i];
+      auto const r = cache.get(key);
+      if (r) {
+        ++hits;
+      }
+      if (!r || i % 10 == 0) {
+        cache.put(key, key, 1 + static_cast<int>(key % 15));
+      }
+    }
+  }
+  state.counters["hit_rate"] = static_cast<double>(hits) /
+                               static_cast<double>(state.iterations() * OPS);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(OPS));
+}
+// Every entry put with a TTL short enough that many expire during a run, so that
+// both the lazy check in get() and the timing wheel do work
+struct TimedLRU : ming::WeightedLRU<std::uint64_t, std::uint64_t> {
+  using WeightedLRU::WeightedLRU;
+
+  void put(std::uint64_t key, std::uint64_t value, int size) {
+    WeightedLRU::put(key, value, size, std::chrono::milliseconds(20));
+  }
+};
+
+BENCHMARK(BM_CacheMixed<ming::WeightedLRU<std::uint64_t, std::uint64_t>>);
+BENCHMARK(BM_CacheMixed<TimedLRU>);
+BENCHMARK(BM_CacheMixed<ListLRU<std::uint64_t, std::uint64_t>>);
+
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,243 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_AHO_CORASICK
+#define MING_AHO_CORASICK
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <ming/trie_node_pool.hpp>
+
+namespace ming {
+
+/**
+ * @brief An Aho-Corasick automaton that finds every occurrence of a set of
+ * patterns in one pass over the text, in time linear in the text plus the number
+ * of matches
+ *
+ * It is compiled from the nodes of a Trie (see Trie::compile()). The failure links
+ * are folded into a complete transition table, so each input byte costs one table
+ * load with no backtracking. To keep the table small, bytes are first mapped to
+ * classes: every byte that labels some trie edge gets its own class and all other
+ * bytes share one, so the table has (states x classes) entries rather than
+ * (states x 256). Output links chain each state to the patterns that end there as
+ * suffixes, and a flag bit in each transition says whether the chain is non-empty.
+ *
+ * The empty pattern is never reported.
+ *
+ * @see https://dl.acm.org/doi/10.1145/360825.360855
+ */
+class AhoCorasick {
+  using index_type = TrieNodePool::index_type;
+
+  /** @brief Set in a transition whose target state has at least one match */
+  static constexpr std::uint32_t OUTPUT = std::uint32_t{1} << 31;
+  static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+  std::array<std::uint8_t, 256> m_class{};
+  std::uint32_t m_classes{0};
+  // m_delta[row + class] = (target row) | OUTPUT?, where row = state * m_classes
+  std::vector<std::uint32_t> m_delta;
+  // Per state: the length of the pattern ending there (0 if none), and the next
+  // state on its failure chain that ends a pattern
+  std::vector<std::uint32_t> m_length;
+  std::vector<std::uint32_t> m_output;
+
+  template <typename F>
+  void m_report(std::uint32_t state, std::size_t end, F &f) const {
+    if (m_length[state] == 0) {
+      state = m_output[state];
+    }
+    for (; state != NONE; state = m_output[state]) {
+      f(end - m_length[state], static_cast<std::size_t>(m_length[state]));
+    }
+  }
+
+public:
+  /**
+   * @brief Incremental matching over text that arrives in pieces. Matches that
+   * straddle two pieces are found, and positions count from the start of the first
+   * piece.
+   */
+  class Stream {
+    AhoCorasick const *m_automaton;
+    std::uint32_t m_row{0};
+    std::size_t m_offset{0};
+
+  public:
+    explicit Stream(AhoCorasick const &automaton) noexcept : m_automaton(&automaton) {}
+
+    /**
+     * @brief Consume the next piece of text
+     *
+     * @param text The piece
+     * @param f Called as f(position, length) for every match ending in `text`, in
+     * order of end position, longest first among matches with the same end
+     * @return std::size_t The number of matches reported
+     */
+    template <typename F>
+    std::size_t feed(std::string_view text, F &&f) {
+      AhoCorasick const &a = *m_automaton;
+      std::uint32_t const *delta = a.m_delta.data();
+      std::size_t matches = 0;
+      auto counted = [&](std::size_t position, std::size_t length) {
+        ++matches;
+        f(position, length);
+      };
+
+      std::uint32_t row = m_row;
+      for (std::size_t i = 0; i < text.size(); ++i) {
+        std::uint32_t const next =
+            delta[row + a.m_class[static_cast<std::uint8_t>(text[i])]];
+        row = next & ~OUTPUT;
+        if (next & OUTPUT) {
+          a.m_report(row / a.m_classes, m_offset + i + 1, counted);
+        }
+      }
+      m_row = row;
+      m_offset += text.size();
+      return matches;
+    }
+
+    /**
+     * @brief Forget the text consumed so far
+     */
+    void reset() noexcept {
+      m_row = 0;
+      m_offset = 0;
+    }
+  };
+
+  /**
+   * @brief Compile the trie stored in `nodes`; each word becomes a pattern
+   *
+   * @param nodes The node pool of a Trie
+   * @throws std::length_error If the transition table would not fit 31-bit offsets
+   */
+  explicit AhoCorasick(TrieNodePool const &nodes) {
+    // Number the states breadth-first, so a state's failure target (always
+    // shallower) is finished before the state itself
+    std::vector<index_type> order{TrieNodePool::ROOT};
+    std::vector<std::uint32_t> depth{0};
+    std::array<bool, 256> used{};
+    for (std::size_t head = 0; head < order.size(); ++head) {
+      nodes.for_each_child(order[head], [&](std::uint8_t label, index_type child) {
+        used[label] = true;
+        order.push_back(child);
+        depth.push_back(depth[head] + 1);
+      });
+    }
+    // Bytes on no edge share the class after the last used one
+    auto const distinct = static_cast<std::uint32_t>(std::ranges::count(used, true));
+    m_classes = distinct + (distinct < 256 ? 1 : 0);
+    std::uint32_t next_class = 0;
+    for (std::size_t c = 0; c < 256; ++c) {
+      m_class[c] = static_cast<std::uint8_t>(used[c] ? next_class++ : distinct);
+    }
+
+    std::size_t const states = order.size();
+    if (states * m_classes >= OUTPUT) {
+      throw std::length_error("AhoCorasick transition table is too large!");
+    }
+    m_delta.assign(states * m_classes, 0);
+    m_length.assign(states, 0);
+    m_output.assign(states, NONE);
+    std::vector<std::uint32_t> fail(states, 0);
+
+    // Transitions hold plain state ids until the final pass
+    std::uint32_t next_state = 1;
+    for (std::uint32_t s = 0; s < states; ++s) {
+      std::uint32_t *row = m_delta.data() + std::size_t{s} * m_classes;
+      if (s != 0) {
+        std::uint32_t const *inherited =
+            m_delta.data() + std::size_t{fail[s]} * m_classes;
+        std::copy(inherited, inherited + m_classes, row);
+      }
+      nodes.for_each_child(order[s], [&](std::uint8_t label, index_type child) {
+        std::uint32_t const t = next_state++;
+        std::uint8_t const c = m_class[label];
+        fail[t] = s == 0 ? 0 : m_delta[std::size_t{fail[s]} * m_classes + c];
+        row[c] = t;
+        if (nodes.terminal(child)) {
+          m_length[t] = depth[t];
+        }
+        m_output[t] = m_length[fail[t]] ? fail[t] : m_output[fail[t]];
+      });
+    }
+
+    for (auto &entry : m_delta) {
+      bool const output = m_length[entry] || m_output[entry] != NONE;
+      entry = entry * m_classes | (output ? OUTPUT : 0);
+    }
+  }
+
+  /**
+   * @brief Start matching a text that will arrive in pieces
+   */
+  [[nodiscard]] Stream stream() const noexcept { return Stream(*this); }
+
+  /**
+   * @brief Report every occurrence of every pattern in `text`
+   *
+   * @param text The text to scan
+   * @param f Called as f(position, length) for every match, in order of end
+   * position, longest first among matches with the same end
+   * @return std::size_t The number of matches reported
+   */
+  template <typename F>
+  std::size_t scan(std::string_view text, F &&f) const {
+    Stream s(*this);
+    return s.feed(text, f);
+  }
+
+  /**
+   * @brief Count the occurrences of all patterns in `text`
+   */
+  [[nodiscard]] std::size_t count(std::string_view text) const {
+    return scan(text, [](std::size_t, std::size_t) {});
+  }
+
+  /**
+   * @brief Get the number of states, one per trie node
+   */
+  [[nodiscard]] std::size_t state_count() const noexcept { return m_length.size(); }
+
+  /**
+   * @brief Get the number of byte classes, i.e. the width of the transition table
+   */
+  [[nodiscard]] std::size_t class_count() const noexcept { return m_classes; }
+
+  /**
+   * @brief Get the number of bytes reserved for the automaton
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return sizeof(m_class) + (m_delta.capacity() + m_length.capacity() +
+                              m_output.capacity()) * sizeof(std::uint32_t);
+  }
+};
+
+} // namespace ming
+
+#endif // MING_AHO_CORASICK
@@ -0,0 +1,520 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_CONCURRENT_SKIPLIST
+#define MING_CONCURRENT_SKIPLIST
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include <ming/epoch_reclaimer.hpp>
+
+namespace ming {
+
+/**
+ * @brief A lock-free ordered map based on the Fraser / Herlihy-Shavit skiplist.
+ * Deletion marks the low bit of a node's forward links (top level first, level 0
+ * last); the level 0 mark is the linearization point. Unlinked nodes are handed to
+ * the EpochReclaimer, so readers never touch freed memory.
+ *
+ * @see https://www.cl.cam.ac.uk/techreports/UCAM-CL-TR-579.pdf
+ *
+ * @tparam Key The key type used for comparison and ordering
+ * @tparam T The value type; values are immutable once published
+ * @tparam Compare The comparison function type
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class ConcurrentSkipListMap {
+private:
+  static constexpr int MAX_LEVEL = 32;
+
+  struct Node;
+
+  /** @brief A forward link whose low bit marks the owning node as deleted */
+  using link = std::atomic<std::uintptr_t>;
+
+  static constexpr std::uintptr_t MARK = 1;
+
+  static Node *ptr_of(std::uintptr_t l) noexcept {
+    return reinterpret_cast<Node *>(l & ~MARK);
+  }
+
+  static bool is_marked(std::uintptr_t l) noexcept { return (l & MARK) != 0; }
+
+  static std::uintptr_t raw(Node *n) noexcept {
+    return reinterpret_cast<std::uintptr_t>(n);
+  }
+
+  /**
+   * @brief Nodes are allocated as a single block: the header followed by `level`
+   * forward links, so a tower costs one allocation.
+   */
+  struct alignas(link) Node {
+    Key key;
+    T value;
+    int level;
+    // 2 while an insert may still be linking upper levels, dropped by the inserter
+    // when it is done and by the thread that logically deletes the node
+    std::atomic<int> pending{2};
+
+    template <typename K, typename V>
+    Node(K &&k, V &&v, int lvl)
+        : key(std::forward<K>(k)), value(std::forward<V>(v)), level(lvl) {}
+
+    link *forward() noexcept { return reinterpret_cast<link *>(this + 1); }
+
+    link &next(int lvl) noexcept { return forward()[lvl]; }
+
+    template <typename K, typename V>
+    static Node *create(K &&k, V &&v, int lvl) {
+      void *mem = ::operator new(sizeof(Node) + sizeof(link) * lvl);
+      auto *n = new (mem) Node(std::forward<K>(k), std::forward<V>(v), lvl);
+      for (int i = 0; i < lvl; ++i) {
+        new (&n->forward()[i]) link(0);
+      }
+      return n;
+    }
+
+    static void destroy(void *p) noexcept {
+      auto *n = static_cast<Node *>(p);
+      n->~Node();
+      ::operator delete(p);
+    }
+  };
+
+  Node *m_head;
+  // highest level any tower has reached; searches start here instead of MAX_LEVEL
+  std::atomic<int> m_level{1};
+  std::atomic<std::size_t> m_size{0};
+  Compare m_compare;
+
+  static int get_random_level() noexcept {
+    thread_local std::uint64_t state =
+        0x9e3779b97f4a7c15ULL ^ reinterpret_cast<std::uintptr_t>(&state);
+    // xorshift64*, then one coin flip per trailing zero (P = 1/2)
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    std::uint64_t word = state * 0x2545f4914f6cdd1dULL;
+    int level = 1 + std::countr_zero(word | (1ULL << (MAX_LEVEL - 1)));
+    return level;
+  }
+
+  bool equal(Key const &a, Key const &b) const noexcept {
+    return !m_compare(a, b) && !m_compare(b, a);
+  }
+
+  /**
+   * @brief Locate the predecessors and successors of `key` at every level,
+   * physically unlinking any marked node found on the way. Only levels below the
+   * current height are filled in. Must be called while pinned.
+   *
+   * @return true If an unmarked node with an equal key is at succs[0]
+   */
+  bool m_find(Key const &key, Node **preds, Node **succs) const noexcept {
+  retry:
+    Node *pred = m_head;
+    for (int lvl = m_level.load(std::memory_order_acquire) - 1; lvl >= 0; --lvl) {
+      Node *curr = ptr_of(pred->next(lvl).load(std::memory_order_acquire));
+      while (curr) {
+        std::uintptr_t succ = curr->next(lvl).load(std::memory_order_acquire);
+        while (is_marked(succ)) {
+          std::uintptr_t expected = raw(curr);
+          if (!pred->next(lvl).compare_exchange_strong(expected, succ & ~MARK,
+                                                       std::memory_order_acq_rel)) {
+            goto retry;
+          }
+          curr = ptr_of(succ);
+          if (!curr) {
+            break;
+          }
+          succ = curr->next(lvl).load(std::memory_order_acquire);
+        }
+        if (!curr || !m_compare(curr->key, key)) {
+          break;
+        }
+        pred = curr;
+        curr = ptr_of(succ);
+      }
+      preds[lvl] = pred;
+      succs[lvl] = curr;
+    }
+    return succs[0] && equal(succs[0]->key, key);
+  }
+
+  /**
+   * @brief Physically unlink every marked node whose key is not greater than
+   * `key`, at every level. Unlike m_find this walks past nodes with an equal key:
+   * a re-insert of `key` can link its tower in front of a marked node with the
+   * same key, which m_find would then never reach. Must be called while pinned.
+   */
+  void m_purge(Key const &key) const noexcept {
+  retry:
+    Node *below = m_head; // last node seen with a key less than `key`
+    for (int lvl = m_level.load(std::memory_order_acquire) - 1; lvl >= 0; --lvl) {
+      Node *pred = below;
+      Node *curr = ptr_of(pred->next(lvl).load(std::memory_order_acquire));
+      while (curr) {
+        std::uintptr_t succ = curr->next(lvl).load(std::memory_order_acquire);
+        if (is_marked(succ)) {
+          std::uintptr_t expected = raw(curr);
+          if (!pred->next(lvl).compare_exchange_strong(expected, succ & ~MARK,
+                                                       std::memory_order_acq_rel)) {
+            goto retry;
+          }
+          curr = ptr_of(succ);
+          continue;
+        }
+        if (m_compare(key, curr->key)) {
+          break;
+        }
+        if (m_compare(curr->key, key)) {
+          below = curr;
+        }
+        pred = curr;
+        curr = ptr_of(succ);
+      }
+    }
+  }
+
+  /**
+   * @brief Wait-free search without helping: skips marked nodes instead of
+   * unlinking them. Must be called while pinned.
+   *
+   * @return The first unmarked node whose key is not less than `key`
+   */
+  Node *m_seek(Key const &key) const noexcept {
+    Node *pred = m_head;
+    Node *curr = nullptr;
+    for (int lvl = m_level.load(std::memory_order_acquire) - 1; lvl >= 0; --lvl) {
+      curr = ptr_of(pred->next(lvl).load(std::memory_order_acquire));
+      while (curr) {
+        std::uintptr_t succ = curr->next(lvl).load(std::memory_order_acquire);
+        if (is_marked(succ)) {
+          curr = ptr_of(succ);
+          continue;
+        }
+        if (!m_compare(curr->key, key)) {
+          break;
+        }
+        pred = curr;
+        curr = ptr_of(succ);
+      }
+    }
+    return curr;
+  }
+
+  static Node *m_next_live(Node *node) noexcept {
+    while (node && is_marked(node->next(0).load(std::memory_order_acquire))) {
+      node = ptr_of(node->next(0).load(std::memory_order_acquire));
+    }
+    return node;
+  }
+
+  /**
+   * @brief Drop one of the two references held by the inserter and the deleter;
+   * whoever drops the last one retires the (already unlinked) node.
+   */
+  static void m_release(Node *node) {
+    if (node->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      EpochReclaimer::instance().retire(node, &Node::destroy);
+    }
+  }
+
+  template <typename K, typename V>
+  bool m_insert(K &&key, V &&value) {
+    auto guard = EpochReclaimer::instance().guard();
+    Node *preds[MAX_LEVEL];
+    Node *succs[MAX_LEVEL];
+
+    Node *node = nullptr;
+    int level = get_random_level();
+    int height = m_level.load(std::memory_order_relaxed);
+    while (height < level &&
+           !m_level.compare_exchange_weak(height, level, std::memory_order_acq_rel)) {
+    }
+
+    while (true) {
+      if (m_find(node ? node->key : key, preds, succs)) {
+        if (node) {
+          Node::destroy(node);
+        }
+        return false;
+      }
+
+      if (!node) {
+        node = Node::create(std::forward<K>(key), std::forward<V>(value), level);
+      }
+      for (int i = 0; i < level; ++i) {
+        node->next(i).store(raw(succs[i]), std::memory_order_relaxed);
+      }
+
+      std::uintptr_t expected = raw(succs[0]);
+      if (preds[0]->next(0).compare_exchange_strong(expected, raw(node),
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    m_size.fetch_add(1, std::memory_order_relaxed);
+
+    Key const &k = node->key;
+    for (int lvl = 1; lvl < level; ++lvl) {
+      while (true) {
+        std::uintptr_t next = node->next(lvl).load(std::memory_order_acquire);
+        if (is_marked(next)) {
+          goto linked;
+        }
+        if (ptr_of(next) != succs[lvl] &&
+            !node->next(lvl).compare_exchange_strong(next, raw(succs[lvl]),
+                                                     std::memory_order_acq_rel)) {
+          goto linked;
+        }
+
+        std::uintptr_t expected = raw(succs[lvl]);
+        if (preds[lvl]->next(lvl).compare_exchange_strong(expected, raw(node),
+                                                          std::memory_order_acq_rel)) {
+          break;
+        }
+        m_find(k, preds, succs);
+        if (succs[0] != node) {
+          // deleted while we were still linking the tower
+          goto linked;
+        }
+      }
+    }
+
+  linked:
+    if (is_marked(node->next(0).load(std::memory_order_acquire))) {
+      m_purge(k);
+    }
+    m_release(node);
+    return true;
+  }
+
+public:
+  /**
+   * @brief Construct a new, empty ConcurrentSkipListMap
+   */
+  ConcurrentSkipListMap() : ConcurrentSkipListMap(Compare{}) {}
+
+  /**
+   * @brief Construct a new ConcurrentSkipListMap with custom comparator
+   *
+   * @param comp The comparison function object
+   */
+  explicit ConcurrentSkipListMap(Compare comp)
+      : m_head(Node::create(Key{}, T{}, MAX_LEVEL)), m_compare(std::move(comp)) {}
+
+  ConcurrentSkipListMap(ConcurrentSkipListMap const &) = delete;
+  ConcurrentSkipListMap &operator=(ConcurrentSkipListMap const &) = delete;
+
+  /**
+   * @brief Destroy the map. No other thread may access it concurrently; nodes
+   * retired earlier are owned by the EpochReclaimer and freed there.
+   */
+  ~ConcurrentSkipListMap() {
+    Node *node = m_head;
+    while (node) {
+      Node *next = ptr_of(node->next(0).load(std::memory_order_relaxed));
+      Node::destroy(node);
+      node = next;
+    }
+  }
+
+  /**
+   * @brief Insert a key-value pair if the key is not present
+   *
+   * @param key The key
+   * @param value The value
+   * @return true If inserted successfully
+   * @return false If not inserted (e.g., duplicate key)
+   */
+  bool insert(Key const &key, T const &value) { return m_insert(key, value); }
+
+  /**
+   * @brief Insert a key-value pair by moving them into the map
+   *
+   * @param key The key
+   * @param value The value
+   * @return true If inserted successfully
+   * @return false If not inserted (e.g., duplicate key)
+   */
+  bool insert(Key &&key, T &&value) {
+    return m_insert(std::move(key), std::move(value));
+  }
+
+  /**
+   * @brief Remove a key from the map
+   *
+   * @param key The key to remove
+   * @return true If this call removed the key
+   * @return false If the key was not present or removed concurrently
+   */
+  bool erase(Key const &key) {
+    auto guard = EpochReclaimer::instance().guard();
+    Node *preds[MAX_LEVEL];
+    Node *succs[MAX_LEVEL];
+
+    if (!m_find(key, preds, succs)) {
+      return false;
+    }
+    Node *victim = succs[0];
+
+    for (int lvl = victim->level - 1; lvl >= 1; --lvl) {
+      std::uintptr_t next = victim->next(lvl).load(std::memory_order_acquire);
+      while (!is_marked(next)) {
+        victim->next(lvl).compare_exchange_weak(next, next | MARK,
+                                                std::memory_order_acq_rel);
+      }
+    }
+
+    std::uintptr_t next = victim->next(0).load(std::memory_order_acquire);
+    while (true) {
+      if (is_marked(next)) {
+        return false;
+      }
+      if (victim->next(0).compare_exchange_strong(next, next | MARK,
+                                                  std::memory_order_acq_rel)) {
+        break;
+      }
+    }
+
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    m_purge(key);
+    m_release(victim);
+    return true;
+  }
+
+  /**
+   * @brief Look up a key
+   *
+   * @param key The key to find
+   * @return std::optional<T> A copy of the value, or std::nullopt if not found
+   */
+  [[nodiscard]] std::optional<T> find(Key const &key) const {
+    auto guard = EpochReclaimer::instance().guard();
+    Node *node = m_seek(key);
+    if (node && equal(node->key, key)) {
+      return node->value;
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Check if a key exists in the map
+   *
+   * @param key The key to check for
+   * @return true If key exists
+   * @return false If key does not exist
+   */
+  [[nodiscard]] bool contains(Key const &key) const {
+    auto guard = EpochReclaimer::instance().guard();
+    Node *node = m_seek(key);
+    return node && equal(node->key, key);
+  }
+
+  /**
+   * @brief Approximate number of elements; exact when no writer is active
+   */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return m_size.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Check if the map is empty
+   */
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Weakly consistent forward iterator. Keeps the creating thread pinned for
+   * as long as it lives, so it must not be handed to another thread. It never
+   * yields a key twice and yields every key present for its whole lifetime.
+   */
+  class iterator {
+  private:
+    EpochReclaimer::Guard m_guard;
+    Node *current;
+
+  public:
+    using value_type = std::pair<const Key &, const T &>;
+    using reference = value_type;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    iterator(EpochReclaimer::Guard guard, Node *node) noexcept
+        : m_guard(std::move(guard)), current(node) {}
+
+    iterator &operator++() noexcept {
+      if (current) {
+        current = m_next_live(ptr_of(current->next(0).load(std::memory_order_acquire)));
+      }
+      return *this;
+    }
+
+    iterator operator++(int) noexcept {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(iterator const &other) const noexcept {
+      return current == other.current;
+    }
+
+    bool operator!=(iterator const &other) const noexcept { return !(*this == other); }
+
+    value_type operator*() const noexcept { return {current->key, current->value}; }
+  };
+
+  /**
+   * @brief Get an iterator to the first live element
+   */
+  iterator begin() const {
+    auto guard = EpochReclaimer::instance().guard();
+    Node *first = m_next_live(ptr_of(m_head->next(0).load(std::memory_order_acquire)));
+    return iterator(std::move(guard), first);
+  }
+
+  /**
+   * @brief Get an iterator to the end
+   */
+  iterator end() const { return iterator(EpochReclaimer::Guard{}, nullptr); }
+
+  /**
+   * @brief Get an iterator to the first live element whose key is not less than
+   * `key`
+   */
+  iterator lower_bound(Key const &key) const {
+    auto guard = EpochReclaimer::instance().guard();
+    Node *node = m_seek(key);
+    return iterator(std::move(guard), node);
+  }
+};
+
+} // namespace ming
+
+#endif // MING_CONCURRENT_SKIPLIST
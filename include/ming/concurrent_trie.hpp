@@ -0,0 +1,379 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_CONCURRENT_TRIE
+#define MING_CONCURRENT_TRIE
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ming/epoch_reclaimer.hpp>
+
+namespace ming {
+
+/**
+ * @brief A trie for read-mostly workloads: lookups are lock-free and never wait
+ * for writers, while updates are serialized and copy-on-write (read-copy-update).
+ *
+ * Nodes are immutable once published. An update copies the nodes on the path from
+ * the root to the word, links the copies to the untouched subtrees, and publishes
+ * the new root with a single atomic store. Every reader therefore sees one
+ * consistent version for the whole of an operation, and the replaced path is
+ * handed to the EpochReclaimer, which frees it once no reader can still hold it.
+ *
+ * Updates cost O(length x fan-out) and allocate a fresh path, so this suits tables
+ * that are read by many threads and changed a few times per second.
+ *
+ * Keys are byte strings (std::string_view).
+ *
+ * @see https://www.kernel.org/doc/html/latest/RCU/whatisRCU.html
+ */
+class ConcurrentTrie {
+  /**
+   * @brief Nodes are allocated as a single block: the header, `count` child
+   * pointers, then their `count` labels in ascending order.
+   */
+  struct alignas(void *) Node {
+    std::uint16_t count;
+    bool terminal;
+
+    Node(std::uint16_t n, bool t) noexcept : count(n), terminal(t) {}
+
+    Node **children() noexcept { return reinterpret_cast<Node **>(this + 1); }
+
+    Node *const *children() const noexcept {
+      return reinterpret_cast<Node *const *>(this + 1);
+    }
+
+    std::uint8_t *labels() noexcept {
+      return reinterpret_cast<std::uint8_t *>(children() + count);
+    }
+
+    std::uint8_t const *labels() const noexcept {
+      return reinterpret_cast<std::uint8_t const *>(children() + count);
+    }
+
+    /**
+     * @brief Find the position of `label` among the children, or `count`
+     */
+    std::size_t position(std::uint8_t label) const noexcept {
+      auto const *hit =
+          static_cast<std::uint8_t const *>(std::memchr(labels(), label, count));
+      return hit ? static_cast<std::size_t>(hit - labels()) : count;
+    }
+
+    Node *child(std::uint8_t label) const noexcept {
+      std::size_t const i = position(label);
+      return i < count ? children()[i] : nullptr;
+    }
+
+    static Node *create(std::size_t n, bool t) {
+      void *mem = ::operator new(sizeof(Node) + n * (sizeof(Node *) + 1));
+      return new (mem) Node(static_cast<std::uint16_t>(n), t);
+    }
+
+    static void destroy(void *p) noexcept { ::operator delete(p); }
+  };
+
+  std::atomic<Node *> m_root;
+  std::atomic<std::size_t> m_size{0};
+  std::mutex m_write;
+
+  static std::uint8_t m_byte(char c) noexcept { return static_cast<std::uint8_t>(c); }
+
+  /**
+   * @brief Copy `node` (or an empty node if null) with its child along `label` set
+   * to `child`, replacing or inserting it
+   */
+  static Node *m_with_child(Node const *node, std::uint8_t label, Node *child) {
+    std::size_t const count = node ? node->count : 0;
+    std::size_t const i = node ? node->position(label) : 0;
+    if (i < count) {
+      Node *copy = Node::create(count, node->terminal);
+      std::memcpy(copy->children(), node->children(), count * sizeof(Node *));
+      std::memcpy(copy->labels(), node->labels(), count);
+      copy->children()[i] = child;
+      return copy;
+    }
+
+    Node *copy = Node::create(count + 1, node && node->terminal);
+    std::size_t j = 0;
+    for (std::size_t k = 0; k < count; ++k) {
+      if (j == k && node->labels()[k] > label) {
+        copy->children()[j] = child;
+        copy->labels()[j] = label;
+        ++j;
+      }
+      copy->children()[j] = node->children()[k];
+      copy->labels()[j] = node->labels()[k];
+      ++j;
+    }
+    if (j == count) {
+      copy->children()[j] = child;
+      copy->labels()[j] = label;
+    }
+    return copy;
+  }
+
+  /**
+   * @brief Copy `node` without its child along `label`
+   */
+  static Node *m_without_child(Node const *node, std::uint8_t label) {
+    Node *copy = Node::create(node->count - 1u, node->terminal);
+    std::size_t j = 0;
+    for (std::size_t k = 0; k < node->count; ++k) {
+      if (node->labels()[k] != label) {
+        copy->children()[j] = node->children()[k];
+        copy->labels()[j] = node->labels()[k];
+        ++j;
+      }
+    }
+    return copy;
+  }
+
+  /**
+   * @brief Copy `node` with a different terminal flag
+   */
+  static Node *m_with_terminal(Node const *node, bool terminal) {
+    Node *copy = Node::create(node->count, terminal);
+    std::memcpy(copy->children(), node->children(), node->count * sizeof(Node *));
+    std::memcpy(copy->labels(), node->labels(), node->count);
+    return copy;
+  }
+
+  /**
+   * @brief Publish `root` and retire the path it replaces. Writer lock held.
+   */
+  void m_publish(Node *root, std::vector<Node *> const &replaced) {
+    m_root.store(root, std::memory_order_release);
+    auto &reclaimer = EpochReclaimer::instance();
+    for (Node *node : replaced) {
+      if (node) {
+        reclaimer.retire(node, &Node::destroy);
+      }
+    }
+  }
+
+  /**
+   * @brief The nodes along `word` from the root; null past the end of the trie.
+   * Writer lock held.
+   */
+  std::vector<Node *> m_path(std::string_view word) const {
+    std::vector<Node *> path;
+    path.reserve(word.size() + 1);
+    Node *node = m_root.load(std::memory_order_relaxed);
+    path.push_back(node);
+    for (char c : word) {
+      node = node ? node->child(m_byte(c)) : nullptr;
+      path.push_back(node);
+    }
+    return path;
+  }
+
+  Node const *m_walk(Node const *node, std::string_view word) const noexcept {
+    for (char c : word) {
+      node = node->child(m_byte(c));
+      if (!node) {
+        return nullptr;
+      }
+    }
+    return node;
+  }
+
+public:
+  /**
+   * @brief Construct a new empty ConcurrentTrie
+   */
+  ConcurrentTrie() : m_root(Node::create(0, false)) {}
+
+  /**
+   * @brief Construct a ConcurrentTrie with initial words
+   *
+   * @param list List of words to insert into the trie
+   */
+  ConcurrentTrie(std::initializer_list<std::string_view> list) : ConcurrentTrie() {
+    for (auto const &str : list) {
+      insert(str);
+    }
+  }
+
+  ConcurrentTrie(ConcurrentTrie const &) = delete;
+  ConcurrentTrie &operator=(ConcurrentTrie const &) = delete;
+
+  /**
+   * @brief Destroy the trie. No other thread may access it concurrently; paths
+   * replaced earlier are owned by the EpochReclaimer and freed there.
+   */
+  ~ConcurrentTrie() {
+    std::vector<Node *> stack{m_root.load(std::memory_order_relaxed)};
+    while (!stack.empty()) {
+      Node *node = stack.back();
+      stack.pop_back();
+      stack.insert(stack.end(), node->children(), node->children() + node->count);
+      Node::destroy(node);
+    }
+  }
+
+  /**
+   * @brief Insert a word, publishing a new version of the trie
+   *
+   * @param word The word to insert
+   * @return true If the word was inserted
+   * @return false If it was already present
+   */
+  bool insert(std::string_view word) {
+    std::lock_guard lock(m_write);
+    std::vector<Node *> const path = m_path(word);
+    if (path.back() && path.back()->terminal) {
+      return false;
+    }
+
+    Node *fresh =
+        path.back() ? m_with_terminal(path.back(), true) : Node::create(0, true);
+    for (std::size_t i = word.size(); i-- > 0;) {
+      fresh = m_with_child(path[i], m_byte(word[i]), fresh);
+    }
+    m_publish(fresh, path);
+    m_size.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Remove a word, pruning the nodes that only led to it, and publish a new
+   * version of the trie
+   *
+   * @param word The word to remove
+   * @return true If the word was removed
+   * @return false If it was not present
+   */
+  bool erase(std::string_view word) {
+    std::lock_guard lock(m_write);
+    std::vector<Node *> const path = m_path(word);
+    if (!path.back() || !path.back()->terminal) {
+      return false;
+    }
+
+    // nullptr stands for "this subtree is now empty and goes away"
+    Node *fresh = path.back()->count ? m_with_terminal(path.back(), false) : nullptr;
+    for (std::size_t i = word.size(); i-- > 0;) {
+      Node const *parent = path[i];
+      if (fresh) {
+        fresh = m_with_child(parent, m_byte(word[i]), fresh);
+      } else if (i > 0 && parent->count == 1 && !parent->terminal) {
+        fresh = nullptr;
+      } else {
+        fresh = m_without_child(parent, m_byte(word[i]));
+      }
+    }
+    m_publish(fresh, path);
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Check if a word exists in the trie (lock-free)
+   *
+   * @param word The word to check for
+   * @return true If the word exists in the trie
+   * @return false If the word does not exist in the trie
+   */
+  [[nodiscard]] bool is_word(std::string_view word) const {
+    auto guard = EpochReclaimer::instance().guard();
+    Node const *node = m_walk(m_root.load(std::memory_order_acquire), word);
+    return node && node->terminal;
+  }
+
+  /**
+   * @brief Check if any word in the trie starts with the given prefix (lock-free)
+   *
+   * @param prefix The prefix to check for
+   * @return true If the prefix exists in the trie
+   * @return false If no word in the trie starts with the prefix
+   */
+  [[nodiscard]] bool starts_with(std::string_view prefix) const {
+    auto guard = EpochReclaimer::instance().guard();
+    return m_walk(m_root.load(std::memory_order_acquire), prefix) != nullptr;
+  }
+
+  /**
+   * @brief Call `f` with every word that starts with `prefix`, in lexicographic
+   * (byte) order. All words come from the same version of the trie, however many
+   * updates are published meanwhile. The string_view passed to `f` is only valid
+   * during the call; `f` must not update this trie.
+   *
+   * @param prefix The prefix to complete
+   * @param f Called as f(std::string_view word)
+   */
+  template <typename F>
+  void for_each_with_prefix(std::string_view prefix, F &&f) const {
+    auto guard = EpochReclaimer::instance().guard();
+    Node const *start = m_walk(m_root.load(std::memory_order_acquire), prefix);
+    if (!start) {
+      return;
+    }
+
+    struct Frame {
+      Node const *node;
+      // The length of the word ending at `node`, and the label leading to it
+      std::size_t depth;
+      std::uint8_t label;
+    };
+    std::string word(prefix);
+    std::vector<Frame> stack{{start, prefix.size(), 0}};
+    while (!stack.empty()) {
+      Frame const top = stack.back();
+      stack.pop_back();
+      if (top.node != start) {
+        word.resize(top.depth - 1);
+        word.push_back(static_cast<char>(top.label));
+      }
+      if (top.node->terminal) {
+        f(std::string_view(word));
+      }
+      for (std::size_t i = top.node->count; i > 0; --i) {
+        stack.push_back(Frame{top.node->children()[i - 1], top.depth + 1,
+                              top.node->labels()[i - 1]});
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of words in the trie
+   */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return m_size.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Check if the trie is empty
+   */
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+};
+
+} // namespace ming
+
+#endif // MING_CONCURRENT_TRIE
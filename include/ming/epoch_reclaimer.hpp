@@ -0,0 +1,343 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_EPOCH_RECLAIMER
+#define MING_EPOCH_RECLAIMER
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#if defined(__SANITIZE_THREAD__)
+#define MING_EPOCH_FENCELESS 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define MING_EPOCH_FENCELESS 1
+#endif
+#endif
+#ifndef MING_EPOCH_FENCELESS
+#define MING_EPOCH_FENCELESS 0
+#endif
+
+namespace ming {
+
+/**
+ * @brief Epoch-based memory reclamation for lock-free containers
+ *
+ * Readers pin the current global epoch for the duration of an operation. Memory
+ * that has been unlinked from a shared structure is retired into a per-thread bag
+ * tagged with the epoch it was retired in, and is only freed once the global epoch
+ * has advanced twice past it, i.e. once no pinned thread can still hold a reference.
+ *
+ * @see https://www.cl.cam.ac.uk/techreports/UCAM-CL-TR-579.pdf
+ */
+class EpochReclaimer {
+  /** @brief Retire this many objects before trying to advance the global epoch */
+  static constexpr std::size_t ADVANCE_INTERVAL = 64;
+  /**
+   * @brief ThreadSanitizer does not model standalone fences, so under it the
+   * pin/scan handoff is made of seq_cst operations on the records instead
+   */
+  static constexpr bool FENCELESS = MING_EPOCH_FENCELESS;
+  static constexpr std::memory_order SCAN_ORDER =
+      FENCELESS ? std::memory_order_seq_cst : std::memory_order_relaxed;
+
+  struct Retired {
+    void *object;
+    void (*deleter)(void *);
+
+    void reclaim() const noexcept { deleter(object); }
+  };
+
+  struct Bag {
+    std::uint64_t epoch{0};
+    std::vector<Retired> items;
+  };
+
+  /**
+   * @brief Per-thread participant record. Records are never freed while the
+   * reclaimer is alive; a record released by an exiting thread is reused.
+   */
+  struct alignas(64) Record {
+    // (epoch << 1) | 1 while pinned, 0 while quiescent
+    std::atomic<std::uint64_t> state{0};
+    std::atomic<bool> in_use{true};
+    Record *next{nullptr};
+
+    unsigned nesting{0};
+    std::size_t retired_since_advance{0};
+    std::array<Bag, 3> bags;
+  };
+
+  /**
+   * @brief Thread-local handle that acquires a record lazily and hands its
+   * remaining garbage over to the reclaimer when the thread exits
+   */
+  struct Handle {
+    Record *record{nullptr};
+
+    ~Handle() {
+      if (record) {
+        instance().release(record);
+      }
+    }
+  };
+
+  std::atomic<std::uint64_t> m_epoch{1};
+  std::atomic<Record *> m_records{nullptr};
+
+  std::mutex m_orphan_mutex;
+  std::vector<Bag> m_orphans;
+
+  EpochReclaimer() = default;
+
+  Record &local() {
+    thread_local Handle handle;
+    if (!handle.record) {
+      handle.record = acquire();
+    }
+    return *handle.record;
+  }
+
+  Record *acquire() {
+    for (auto *r = m_records.load(std::memory_order_acquire); r; r = r->next) {
+      bool expected = false;
+      if (!r->in_use.load(std::memory_order_relaxed) &&
+          r->in_use.compare_exchange_strong(expected, true)) {
+        return r;
+      }
+    }
+
+    auto *r = new Record;
+    r->next = m_records.load(std::memory_order_relaxed);
+    while (!m_records.compare_exchange_weak(r->next, r, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+    }
+    return r;
+  }
+
+  void release(Record *r) {
+    {
+      std::lock_guard lock(m_orphan_mutex);
+      for (auto &bag : r->bags) {
+        if (!bag.items.empty()) {
+          m_orphans.push_back(std::exchange(bag, Bag{}));
+        }
+      }
+    }
+    r->state.store(0, std::memory_order_release);
+    r->nesting = 0;
+    r->in_use.store(false, std::memory_order_release);
+  }
+
+  /**
+   * @brief Advance the global epoch if every pinned thread has observed it
+   *
+   * @return The (possibly new) global epoch
+   */
+  std::uint64_t try_advance() noexcept {
+    std::uint64_t epoch = m_epoch.load(SCAN_ORDER);
+    if constexpr (!FENCELESS) {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    for (auto *r = m_records.load(std::memory_order_acquire); r; r = r->next) {
+      std::uint64_t state = r->state.load(SCAN_ORDER);
+      if ((state & 1) && (state >> 1) != epoch) {
+        return epoch;
+      }
+    }
+
+    if constexpr (!FENCELESS) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    m_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_release,
+                                    std::memory_order_relaxed);
+    return m_epoch.load(std::memory_order_relaxed);
+  }
+
+  static void collect(Bag &bag, std::uint64_t epoch) noexcept {
+    if (bag.epoch + 2 > epoch) {
+      return;
+    }
+    for (auto const &item : bag.items) {
+      item.reclaim();
+    }
+    bag.items.clear();
+  }
+
+  void collect_orphans(std::uint64_t epoch) {
+    std::unique_lock lock(m_orphan_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      return;
+    }
+    std::erase_if(m_orphans, [epoch](Bag &bag) {
+      collect(bag, epoch);
+      return bag.items.empty();
+    });
+  }
+
+  void unpin() noexcept {
+    auto &r = local();
+    if (--r.nesting == 0) {
+      r.state.store(0, std::memory_order_release);
+    }
+  }
+
+public:
+  /**
+   * @brief RAII critical section. Pointers loaded from a shared structure stay
+   * valid until the guard that was active when they were loaded is destroyed.
+   */
+  class Guard {
+    EpochReclaimer *m_owner;
+
+  public:
+    /**
+     * @brief An empty guard that does not pin anything
+     */
+    Guard() noexcept : m_owner(nullptr) {}
+
+    explicit Guard(EpochReclaimer &owner) : m_owner(&owner) { m_owner->pin(); }
+
+    Guard(Guard const &other) : m_owner(other.m_owner) {
+      if (m_owner) {
+        m_owner->pin();
+      }
+    }
+
+    Guard(Guard &&other) noexcept : m_owner(std::exchange(other.m_owner, nullptr)) {}
+
+    Guard &operator=(Guard other) noexcept {
+      std::swap(m_owner, other.m_owner);
+      return *this;
+    }
+
+    ~Guard() {
+      if (m_owner) {
+        m_owner->unpin();
+      }
+    }
+  };
+
+  EpochReclaimer(EpochReclaimer const &) = delete;
+  EpochReclaimer &operator=(EpochReclaimer const &) = delete;
+
+  ~EpochReclaimer() {
+    for (auto &bag : m_orphans) {
+      for (auto const &item : bag.items) {
+        item.reclaim();
+      }
+    }
+    for (auto *r = m_records.load(); r;) {
+      for (auto &bag : r->bags) {
+        for (auto const &item : bag.items) {
+          item.reclaim();
+        }
+      }
+      delete std::exchange(r, r->next);
+    }
+  }
+
+  /**
+   * @brief The process-wide reclaimer shared by all lock-free containers
+   */
+  static EpochReclaimer &instance() {
+    static EpochReclaimer reclaimer;
+    return reclaimer;
+  }
+
+  /**
+   * @brief Enter a critical section on the calling thread (re-entrant)
+   */
+  void pin() {
+    auto &r = local();
+    if (r.nesting++ == 0) {
+      r.state.store((m_epoch.load(SCAN_ORDER) << 1) | 1, SCAN_ORDER);
+      if constexpr (!FENCELESS) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+      }
+    }
+  }
+
+  /**
+   * @brief Pin the calling thread for the lifetime of the returned guard
+   */
+  [[nodiscard]] Guard guard() { return Guard(*this); }
+
+  /**
+   * @brief Hand an unlinked object over for deferred destruction. The caller must
+   * guarantee that no new references to it can be obtained from shared memory.
+   *
+   * @param object The object to destroy once no thread can observe it
+   * @param deleter Function used to destroy the object
+   */
+  void retire(void *object, void (*deleter)(void *)) {
+    auto &r = local();
+    std::uint64_t epoch = m_epoch.load(std::memory_order_acquire);
+
+    if (++r.retired_since_advance >= ADVANCE_INTERVAL) {
+      r.retired_since_advance = 0;
+      epoch = try_advance();
+      collect_orphans(epoch);
+    }
+
+    for (auto &bag : r.bags) {
+      collect(bag, epoch);
+    }
+
+    auto &bag = r.bags[epoch % r.bags.size()];
+    bag.epoch = epoch;
+    bag.items.push_back({object, deleter});
+  }
+
+  /**
+   * @brief Retire an object allocated with `new`
+   *
+   * @param object The object to delete once no thread can observe it
+   */
+  template <typename T>
+  void retire(T *object) {
+    retire(static_cast<void *>(object),
+           [](void *p) { delete static_cast<T *>(p); });
+  }
+
+  /**
+   * @brief Drive the epoch forward and free everything that becomes reclaimable.
+   * Intended for quiescent points (e.g. tests, shutdown); never call while pinned.
+   */
+  void synchronize() {
+    auto &r = local();
+    for (int i = 0; i < 3; ++i) {
+      try_advance();
+    }
+    std::uint64_t epoch = m_epoch.load(std::memory_order_acquire);
+    for (auto &bag : r.bags) {
+      collect(bag, epoch);
+    }
+    collect_orphans(epoch);
+  }
+};
+
+} // namespace ming
+
+#endif // MING_EPOCH_RECLAIMER
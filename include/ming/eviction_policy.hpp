@@ -0,0 +1,632 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_EVICTION_POLICY
+#define MING_EVICTION_POLICY
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ming {
+
+/**
+ * @brief An eviction order for WeightedLRU. The cache names its entries by slab
+ * slot, and tells the policy about each of them through
+ *
+ * - `insert(e, tag, size)`: entry `e`, whose key hashes to `tag`, was added
+ * - `access(e)`: `e` was read or updated; must not throw
+ * - `resize(e, size)`: an update changed the weight of `e`
+ * - `victim()`: which entry to evict next, or the largest `std::uint32_t` if there
+ * is none; may reorder entries but must keep them all
+ * - `erase(e, evicted)`: `e` was removed, to make room if `evicted`
+ *
+ * If `insert` or `erase` throws, the policy must be left as it was; `erase` with
+ * `evicted` false must not throw.
+ *
+ * A policy is constructed from the cache's capacity, and reports the bytes it
+ * reserves through `memory_usage()`.
+ */
+template <typename P>
+concept EvictionPolicy =
+    std::constructible_from<P, int> &&
+    requires(P p, P const cp, std::uint32_t e, int size, bool evicted) {
+      p.insert(e, e, size);
+      p.access(e);
+      p.resize(e, size);
+      { p.victim() } -> std::same_as<std::uint32_t>;
+      p.erase(e, evicted);
+      { cp.memory_usage() } -> std::convertible_to<std::size_t>;
+    };
+
+namespace detail {
+
+inline constexpr std::uint32_t NO_ENTRY = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Get a policy's node for entry `e`, growing its node array to reach it
+ */
+template <typename Node>
+Node &node_at(std::vector<Node> &nodes, std::uint32_t e) {
+  if (e >= nodes.size()) {
+    nodes.resize(std::size_t{e} + 1);
+  }
+  return nodes[e];
+}
+
+/**
+ * @brief A doubly linked list of entries, threaded through the `prev` and `next`
+ * fields of a policy's nodes, from the front (newest) to the back (oldest)
+ */
+class EntryList {
+  std::uint32_t m_head{NO_ENTRY};
+  std::uint32_t m_tail{NO_ENTRY};
+  std::size_t m_size{0};
+
+public:
+  template <typename Node>
+  void push_front(std::vector<Node> &nodes, std::uint32_t e) noexcept {
+    Node &node = nodes[e];
+    node.prev = NO_ENTRY;
+    node.next = m_head;
+    (m_head == NO_ENTRY ? m_tail : nodes[m_head].prev) = e;
+    m_head = e;
+    ++m_size;
+  }
+
+  template <typename Node>
+  void unlink(std::vector<Node> &nodes, std::uint32_t e) noexcept {
+    Node &node = nodes[e];
+    (node.prev == NO_ENTRY ? m_head : nodes[node.prev].next) = node.next;
+    (node.next == NO_ENTRY ? m_tail : nodes[node.next].prev) = node.prev;
+    --m_size;
+  }
+
+  template <typename Node>
+  void move_to_front(std::vector<Node> &nodes, std::uint32_t e) noexcept {
+    if (e != m_head) {
+      unlink(nodes, e);
+      push_front(nodes, e);
+    }
+  }
+
+  [[nodiscard]] std::uint32_t back() const noexcept { return m_tail; }
+  [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+};
+
+/**
+ * @brief The key hashes of recently evicted entries, oldest first, for policies
+ * that remember what they evicted
+ */
+class GhostList {
+  // Every push is queued with a serial number; a queued tag whose number no
+  // longer matches m_live was removed or pushed again, and is skipped
+  std::deque<std::pair<std::uint32_t, std::uint64_t>> m_order;
+  std::unordered_map<std::uint32_t, std::uint64_t> m_live;
+  std::uint64_t m_serial{0};
+
+  bool m_stale(std::pair<std::uint32_t, std::uint64_t> const &queued) const {
+    auto const it = m_live.find(queued.first);
+    return it == m_live.end() || it->second != queued.second;
+  }
+
+public:
+  void push(std::uint32_t tag) {
+    // Queued first: if remembering the tag then fails, the queued copy is stale
+    m_order.emplace_back(tag, ++m_serial);
+    m_live[tag] = m_serial;
+    if (m_order.size() > 2 * m_live.size() + 64) {
+      std::erase_if(m_order, [this](auto const &queued) { return m_stale(queued); });
+    }
+  }
+
+  /**
+   * @brief Forget `tag`
+   *
+   * @return bool Whether it was remembered
+   */
+  bool erase(std::uint32_t tag) { return m_live.erase(tag) > 0; }
+
+  /**
+   * @brief Forget the oldest tags until at most `limit` remain
+   */
+  void trim(std::size_t limit) {
+    while (m_live.size() > limit) {
+      auto const queued = m_order.front();
+      m_order.pop_front();
+      if (!m_stale(queued)) {
+        m_live.erase(queued.first);
+      }
+    }
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_live.size(); }
+
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_order.size() * sizeof(m_order.front()) +
+           m_live.bucket_count() * sizeof(void *) +
+           m_live.size() * (sizeof(*m_live.begin()) + 2 * sizeof(void *));
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Least recently used: evict the entry that has gone unused the longest
+ */
+class LRUPolicy {
+  struct Node {
+    std::uint32_t prev{detail::NO_ENTRY};
+    std::uint32_t next{detail::NO_ENTRY};
+  };
+
+  std::vector<Node> m_nodes;
+  detail::EntryList m_list;
+
+public:
+  explicit LRUPolicy(int /*capacity*/) {}
+
+  void insert(std::uint32_t e, std::uint32_t /*tag*/, int /*size*/) {
+    detail::node_at(m_nodes, e);
+    m_list.push_front(m_nodes, e);
+  }
+
+  void access(std::uint32_t e) noexcept { m_list.move_to_front(m_nodes, e); }
+
+  void resize(std::uint32_t /*e*/, int /*size*/) noexcept {}
+
+  [[nodiscard]] std::uint32_t victim() const noexcept { return m_list.back(); }
+
+  void erase(std::uint32_t e, bool /*evicted*/) noexcept { m_list.unlink(m_nodes, e); }
+
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_nodes.capacity() * sizeof(Node);
+  }
+};
+
+/**
+ * @brief Segmented LRU: new entries start on probation, and move to a protected
+ * segment holding up to 80% of the weight once they are used again
+ *
+ * Eviction takes the least recently used entry on probation, so a burst of
+ * entries that are used once cannot push out entries that were used twice.
+ * Entries overflowing the protected segment are demoted back to probation.
+ */
+class SLRUPolicy {
+  struct Node {
+    std::uint32_t prev{detail::NO_ENTRY};
+    std::uint32_t next{detail::NO_ENTRY};
+    int size{0};
+    bool is_protected{false};
+  };
+
+  std::vector<Node> m_nodes;
+  detail::EntryList m_probation;
+  detail::EntryList m_protected;
+  int m_protected_weight{0};
+  int m_protected_capacity;
+
+  void m_demote() noexcept {
+    while (m_protected_weight > m_protected_capacity) {
+      std::uint32_t const e = m_protected.back();
+      m_protected.unlink(m_nodes, e);
+      m_nodes[e].is_protected = false;
+      m_protected_weight -= m_nodes[e].size;
+      m_probation.push_front(m_nodes, e);
+    }
+  }
+
+public:
+  explicit SLRUPolicy(int capacity) : m_protected_capacity(capacity - capacity / 5) {}
+
+  void insert(std::uint32_t e, std::uint32_t /*tag*/, int size) {
+    detail::node_at(m_nodes, e) = Node{.size = size};
+    m_probation.push_front(m_nodes, e);
+  }
+
+  void access(std::uint32_t e) noexcept {
+    Node &node = m_nodes[e];
+    if (node.is_protected) {
+      m_protected.move_to_front(m_nodes, e);
+      return;
+    }
+    m_probation.unlink(m_nodes, e);
+    node.is_protected = true;
+    m_protected_weight += node.size;
+    m_protected.push_front(m_nodes, e);
+    m_demote();
+  }
+
+  void resize(std::uint32_t e, int size) noexcept {
+    Node &node = m_nodes[e];
+    if (node.is_protected) {
+      m_protected_weight += size - node.size;
+    }
+    node.size = size;
+    m_demote();
+  }
+
+  [[nodiscard]] std::uint32_t victim() const noexcept {
+    return m_probation.empty() ? m_protected.back() : m_probation.back();
+  }
+
+  void erase(std::uint32_t e, bool /*evicted*/) noexcept {
+    Node const &node = m_nodes[e];
+    if (node.is_protected) {
+      m_protected.unlink(m_nodes, e);
+      m_protected_weight -= node.size;
+    } else {
+      m_probation.unlink(m_nodes, e);
+    }
+  }
+
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_nodes.capacity() * sizeof(Node);
+  }
+};
+
+/**
+ * @brief Adaptive Replacement Cache: balance an LRU of entries seen once against
+ * an LRU of entries seen again, steered by the keys each of them evicted
+ *
+ * The weight target of the first list grows whenever a key it evicted comes back,
+ * and shrinks whenever a key the second list evicted comes back. The ghost lists
+ * of evicted keys each remember at most as many keys as there are cached entries.
+ * Unlike in the paper, the cache evicts before it inserts, so a returning key
+ * moves the target for the next eviction rather than for its own.
+ *
+ * @see https://www.usenix.org/legacy/events/fast03/tech/megiddo.html
+ */
+class ARCPolicy {
+  struct Node {
+    std::uint32_t prev{detail::NO_ENTRY};
+    std::uint32_t next{detail::NO_ENTRY};
+    int size{0};
+    std::uint32_t tag{0};
+    bool frequent{false};
+  };
+
+  std::vector<Node> m_nodes;
+  detail::EntryList m_recent;
+  detail::EntryList m_frequent;
+  detail::GhostList m_recent_ghosts;
+  detail::GhostList m_frequent_ghosts;
+  int m_capacity;
+  int m_recent_weight{0};
+  // The weight the recent list may keep before it, and not the frequent list,
+  // gives up entries
+  int m_target{0};
+
+  /**
+   * @brief How far a returning key moves the target: its weight, scaled by how
+   * much longer the other ghost list is
+   */
+  static int m_step(int size, std::size_t ghosts, std::size_t other_ghosts) {
+    std::size_t const ratio = std::max<std::size_t>(other_ghosts / ghosts, 1);
+    return static_cast<int>(std::min<std::size_t>(
+        static_cast<std::size_t>(std::max(size, 1)) * ratio,
+        std::numeric_limits<int>::max()));
+  }
+
+public:
+  explicit ARCPolicy(int capacity) : m_capacity(capacity) {}
+
+  void insert(std::uint32_t e, std::uint32_t tag, int size) {
+    detail::node_at(m_nodes, e) = Node{.size = size, .tag = tag};
+    std::size_t const recent_ghosts = m_recent_ghosts.size();
+    std::size_t const frequent_ghosts = m_frequent_ghosts.size();
+    if (m_recent_ghosts.erase(tag)) {
+      m_target += std::min(m_capacity - m_target,
+                           m_step(size, recent_ghosts, frequent_ghosts));
+    } else if (m_frequent_ghosts.erase(tag)) {
+      m_target -= std::min(m_target, m_step(size, frequent_ghosts, recent_ghosts));
+    } else {
+      m_recent_weight += size;
+      m_recent.push_front(m_nodes, e);
+      return;
+    }
+    m_nodes[e].frequent = true;
+    m_frequent.push_front(m_nodes, e);
+  }
+
+  void access(std::uint32_t e) noexcept {
+    Node &node = m_nodes[e];
+    if (node.frequent) {
+      m_frequent.move_to_front(m_nodes, e);
+      return;
+    }
+    m_recent.unlink(m_nodes, e);
+    m_recent_weight -= node.size;
+    node.frequent = true;
+    m_frequent.push_front(m_nodes, e);
+  }
+
+  void resize(std::uint32_t e, int size) noexcept {
+    Node &node = m_nodes[e];
+    if (!node.frequent) {
+      m_recent_weight += size - node.size;
+    }
+    node.size = size;
+  }
+
+  [[nodiscard]] std::uint32_t victim() const noexcept {
+    if (!m_recent.empty() && (m_recent_weight > m_target || m_frequent.empty())) {
+      return m_recent.back();
+    }
+    return m_frequent.back();
+  }
+
+  void erase(std::uint32_t e, bool evicted) {
+    Node const &node = m_nodes[e];
+    // The only step that may throw goes first, so a failure leaves `e` cached
+    if (evicted) {
+      (node.frequent ? m_frequent_ghosts : m_recent_ghosts).push(node.tag);
+    }
+    if (node.frequent) {
+      m_frequent.unlink(m_nodes, e);
+    } else {
+      m_recent.unlink(m_nodes, e);
+      m_recent_weight -= node.size;
+    }
+    if (evicted) {
+      std::size_t const cached = m_recent.size() + m_frequent.size();
+      m_recent_ghosts.trim(cached);
+      m_frequent_ghosts.trim(cached);
+    }
+  }
+
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_nodes.capacity() * sizeof(Node) + m_recent_ghosts.memory_usage() +
+           m_frequent_ghosts.memory_usage();
+  }
+};
+
+/**
+ * @brief S3-FIFO: a small FIFO queue holding 10% of the weight filters out entries
+ * that are never used again, in front of a main FIFO queue with second chances
+ *
+ * A read only bumps a 2-bit counter and moves nothing. An entry leaving the small
+ * queue moves to the main queue if it was read while queued, and is otherwise
+ * evicted, its key remembered in a ghost list as long as the cache's entry count;
+ * a remembered key that comes back goes straight to the main queue. An entry
+ * leaving the main queue is reinserted at its front with its counter decremented,
+ * until the counter reaches zero.
+ *
+ * @see https://dl.acm.org/doi/10.1145/3600006.3613147
+ */
+class S3FIFOPolicy {
+  static constexpr std::uint8_t MAX_FREQUENCY = 3;
+
+  struct Node {
+    std::uint32_t prev{detail::NO_ENTRY};
+    std::uint32_t next{detail::NO_ENTRY};
+    int size{0};
+    std::uint32_t tag{0};
+    std::uint8_t frequency{0};
+    bool main{false};
+  };
+
+  std::vector<Node> m_nodes;
+  detail::EntryList m_small;
+  detail::EntryList m_main;
+  detail::GhostList m_ghosts;
+  int m_small_weight{0};
+  int m_small_capacity;
+
+public:
+  explicit S3FIFOPolicy(int capacity) : m_small_capacity(std::max(capacity / 10, 1)) {}
+
+  void insert(std::uint32_t e, std::uint32_t tag, int size) {
+    Node &node = detail::node_at(m_nodes, e) = Node{.size = size, .tag = tag};
+    if (m_ghosts.erase(tag)) {
+      node.main = true;
+      m_main.push_front(m_nodes, e);
+    } else {
+      m_small_weight += size;
+      m_small.push_front(m_nodes, e);
+    }
+  }
+
+  void access(std::uint32_t e) noexcept {
+    Node &node = m_nodes[e];
+    node.frequency = std::min<std::uint8_t>(node.frequency + 1, MAX_FREQUENCY);
+  }
+
+  void resize(std::uint32_t e, int size) noexcept {
+    Node &node = m_nodes[e];
+    if (!node.main) {
+      m_small_weight += size - node.size;
+    }
+    node.size = size;
+  }
+
+  [[nodiscard]] std::uint32_t victim() noexcept {
+    // Every pass either finds the victim, or moves an entry out of the small
+    // queue, or lowers a counter, so this ends
+    for (;;) {
+      if (!m_small.empty() && (m_small_weight > m_small_capacity || m_main.empty())) {
+        std::uint32_t const e = m_small.back();
+        Node &node = m_nodes[e];
+        if (node.frequency == 0) {
+          return e;
+        }
+        m_small.unlink(m_nodes, e);
+        m_small_weight -= node.size;
+        node.main = true;
+        node.frequency = 0;
+        m_main.push_front(m_nodes, e);
+      } else if (!m_main.empty()) {
+        std::uint32_t const e = m_main.back();
+        Node &node = m_nodes[e];
+        if (node.frequency == 0) {
+          return e;
+        }
+        --node.frequency;
+        m_main.move_to_front(m_nodes, e);
+      } else {
+        return detail::NO_ENTRY;
+      }
+    }
+  }
+
+  void erase(std::uint32_t e, bool evicted) {
+    Node const &node = m_nodes[e];
+    if (node.main) {
+      m_main.unlink(m_nodes, e);
+      return;
+    }
+    // The only step that may throw goes first, so a failure leaves `e` cached
+    if (evicted) {
+      m_ghosts.push(node.tag);
+    }
+    m_small.unlink(m_nodes, e);
+    m_small_weight -= node.size;
+    if (evicted) {
+      m_ghosts.trim(m_small.size() + m_main.size());
+    }
+  }
+
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_nodes.capacity() * sizeof(Node) + m_ghosts.memory_usage();
+  }
+};
+
+/**
+ * @brief GreedyDual-Size-Frequency: evict the entry with the lowest priority,
+ * `L + frequency / size`, where L is the priority of the last evicted entry
+ *
+ * Small, often used entries are kept over large, rarely used ones, which raises
+ * the hit rate per unit of weight; the rising L ages entries that stop being
+ * used. Entries are kept in a binary min-heap on their priority.
+ *
+ * @see https://www.hpl.hp.com/techreports/98/HPL-98-173.pdf
+ */
+class GDSFPolicy {
+  struct Node {
+    double priority{0};
+    std::uint32_t frequency{0};
+    int size{0};
+    std::uint32_t position{0};
+  };
+
+  std::vector<Node> m_nodes;
+  std::vector<std::uint32_t> m_heap;
+  double m_inflation{0};
+
+  void m_prioritize(std::uint32_t e) noexcept {
+    Node &node = m_nodes[e];
+    node.priority = m_inflation + static_cast<double>(node.frequency) /
+                                      static_cast<double>(std::max(node.size, 1));
+  }
+
+  void m_place(std::size_t i, std::uint32_t e) noexcept {
+    m_heap[i] = e;
+    m_nodes[e].position = static_cast<std::uint32_t>(i);
+  }
+
+  void m_sift_up(std::size_t i) noexcept {
+    std::uint32_t const e = m_heap[i];
+    while (i > 0) {
+      std::size_t const parent = (i - 1) / 2;
+      if (m_nodes[m_heap[parent]].priority <= m_nodes[e].priority) {
+        break;
+      }
+      m_place(i, m_heap[parent]);
+      i = parent;
+    }
+    m_place(i, e);
+  }
+
+  void m_sift_down(std::size_t i) noexcept {
+    std::uint32_t const e = m_heap[i];
+    for (;;) {
+      std::size_t child = 2 * i + 1;
+      if (child >= m_heap.size()) {
+        break;
+      }
+      if (child + 1 < m_heap.size() &&
+          m_nodes[m_heap[child + 1]].priority < m_nodes[m_heap[child]].priority) {
+        ++child;
+      }
+      if (m_nodes[e].priority <= m_nodes[m_heap[child]].priority) {
+        break;
+      }
+      m_place(i, m_heap[child]);
+      i = child;
+    }
+    m_place(i, e);
+  }
+
+public:
+  explicit GDSFPolicy(int /*capacity*/) {}
+
+  void insert(std::uint32_t e, std::uint32_t /*tag*/, int size) {
+    detail::node_at(m_nodes, e) = Node{.frequency = 1, .size = size};
+    m_prioritize(e);
+    m_heap.push_back(e);
+    m_sift_up(m_heap.size() - 1);
+  }
+
+  void access(std::uint32_t e) noexcept {
+    ++m_nodes[e].frequency;
+    // L never falls, so the priority can only rise
+    m_prioritize(e);
+    m_sift_down(m_nodes[e].position);
+  }
+
+  void resize(std::uint32_t e, int size) noexcept {
+    m_nodes[e].size = size;
+    m_prioritize(e);
+    m_sift_up(m_nodes[e].position);
+    m_sift_down(m_nodes[e].position);
+  }
+
+  [[nodiscard]] std::uint32_t victim() const noexcept {
+    return m_heap.empty() ? detail::NO_ENTRY : m_heap.front();
+  }
+
+  void erase(std::uint32_t e, bool evicted) noexcept {
+    if (evicted) {
+      m_inflation = m_nodes[e].priority;
+    }
+    std::size_t const i = m_nodes[e].position;
+    std::uint32_t const last = m_heap.back();
+    m_heap.pop_back();
+    if (i < m_heap.size()) {
+      m_place(i, last);
+      m_sift_up(i);
+      m_sift_down(m_nodes[last].position);
+    }
+  }
+
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_nodes.capacity() * sizeof(Node) +
+           m_heap.capacity() * sizeof(std::uint32_t);
+  }
+};
+
+} // namespace ming
+
+#endif // MING_EVICTION_POLICY
@@ -0,0 +1,160 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_FREQUENCY_SKETCH
+#define MING_FREQUENCY_SKETCH
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ming {
+
+/**
+ * @brief A Count-Min sketch of how often keys have been seen recently, in 4-bit
+ * counters
+ *
+ * Each key maps to one counter in each of four rows, and its estimate is the
+ * smallest of the four, which can overestimate (on collisions) but never
+ * underestimate. Increments are conservative: only the counters holding that
+ * minimum are raised. Counters saturate at 15, and once the sketch has recorded
+ * ten increments per expected key, every counter is halved, so the estimates
+ * follow recent popularity rather than all history.
+ *
+ * @see https://arxiv.org/abs/1512.00727
+ *
+ * @tparam K The key type; hashed with std::hash<K>
+ */
+template <typename K>
+class FrequencySketch {
+  /** @brief The mask that halves all 16 counters of a word at once after a shift */
+  static constexpr std::uint64_t HALF = 0x7777777777777777ULL;
+  static constexpr std::uint64_t SEEDS[4] = {
+      0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL, 0x94d049bb133111ebULL,
+      0xd6e8feb86659fd93ULL};
+
+  // Every word packs 16 counters; all four rows share the table, one word per
+  // expected key
+  std::vector<std::uint64_t> m_table;
+  std::size_t m_mask;
+  std::size_t m_additions{0};
+  std::size_t m_sample_size;
+
+  struct Counter {
+    std::size_t word;
+    unsigned shift;
+  };
+
+  Counter m_counter(std::uint64_t h, std::size_t row) const noexcept {
+    std::uint64_t const x = h * SEEDS[row];
+    return Counter{static_cast<std::size_t>(x >> 32) & m_mask,
+                   static_cast<unsigned>(x >> 60) * 4};
+  }
+
+  unsigned m_value(Counter c) const noexcept {
+    return static_cast<unsigned>(m_table[c.word] >> c.shift) & 15u;
+  }
+
+  static std::uint64_t m_hash(K const &key) {
+    // The splitmix64 finalizer, since std::hash is often the identity
+    auto h = static_cast<std::uint64_t>(std::hash<K>{}(key));
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+  }
+
+  void m_age() noexcept {
+    for (auto &word : m_table) {
+      word = (word >> 1) & HALF;
+    }
+    m_additions /= 2;
+  }
+
+public:
+  /**
+   * @brief Construct an empty sketch
+   *
+   * @param expected_keys About how many distinct keys matter at once, e.g. the
+   * number of entries a cache holds; sets the width and the aging period
+   */
+  explicit FrequencySketch(std::size_t expected_keys)
+      : m_table(std::bit_ceil(std::max<std::size_t>(expected_keys, 16))),
+        m_mask(m_table.size() - 1),
+        m_sample_size(10 * std::max<std::size_t>(expected_keys, 16)) {}
+
+  /**
+   * @brief Record one occurrence of `key`
+   */
+  void increment(K const &key) {
+    std::uint64_t const h = m_hash(key);
+    Counter counters[4];
+    unsigned least = 15;
+    for (std::size_t row = 0; row < 4; ++row) {
+      counters[row] = m_counter(h, row);
+      least = std::min(least, m_value(counters[row]));
+    }
+    if (least == 15) {
+      return;
+    }
+    for (Counter c : counters) {
+      // Two rows may share a counter; it must only be raised once
+      if (m_value(c) == least) {
+        m_table[c.word] += std::uint64_t{1} << c.shift;
+      }
+    }
+    if (++m_additions >= m_sample_size) {
+      m_age();
+    }
+  }
+
+  /**
+   * @brief Estimate how often `key` has been seen recently
+   *
+   * @return unsigned The estimate, from 0 to 15
+   */
+  [[nodiscard]] unsigned frequency(K const &key) const {
+    std::uint64_t const h = m_hash(key);
+    unsigned least = 15;
+    for (std::size_t row = 0; row < 4; ++row) {
+      least = std::min(least, m_value(m_counter(h, row)));
+    }
+    return least;
+  }
+
+  /**
+   * @brief Forget every key
+   */
+  void clear() noexcept {
+    std::ranges::fill(m_table, 0);
+    m_additions = 0;
+  }
+
+  /**
+   * @brief Get the number of bytes reserved for the counters
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_table.capacity() * sizeof(std::uint64_t);
+  }
+};
+
+} // namespace ming
+
+#endif // MING_FREQUENCY_SKETCH
@@ -0,0 +1,481 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_LOUDS_TRIE
+#define MING_LOUDS_TRIE
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <ming/mapped_file.hpp>
+#include <ming/trie_node_pool.hpp>
+
+namespace ming {
+
+/**
+ * @brief An immutable trie in the LOUDS (level-order unary degree sequence)
+ * encoding, at roughly 11 bits per node: 2 for the tree shape, 8 for the label and
+ * 1 for the end-of-word flag, plus a small rank/select directory.
+ *
+ * Nodes are numbered in breadth-first order. The shape is the bit string "10"
+ * followed by, for each node, one 1 per child and a terminating 0. The children of
+ * node i start right after the i-th 0, the first of them is node
+ * (start - i - 1), and their labels are contiguous and sorted, so one select0 per
+ * character is all a lookup needs.
+ *
+ * The whole structure is a single array of 64-bit words, so it can be written to a
+ * file and memory-mapped back without any parsing; opening a frozen dictionary only
+ * validates its directories in one pass, and its pages are shared between processes.
+ *
+ * @see https://doi.org/10.1109/SFCS.1989.63533
+ */
+class LoudsTrie {
+  static constexpr std::uint64_t MAGIC = 0x44554f4c474e494dULL; // "MINGLOUD"
+
+  // Ones are counted per 512-bit block; every 512th zero has its block sampled
+  static constexpr std::size_t BLOCK_BITS = 512;
+  static constexpr std::size_t BLOCK_WORDS = BLOCK_BITS / 64;
+  static constexpr std::size_t SELECT_SAMPLE = 512;
+
+  struct Header {
+    std::uint64_t magic;
+    // Length of the whole encoding in 64-bit words, header included
+    std::uint64_t words;
+    std::uint64_t nodes;
+    std::uint64_t keys;
+    std::uint64_t louds_bits;
+    std::uint64_t louds_words;
+    std::uint64_t rank_blocks;
+    std::uint64_t select_hints;
+    std::uint64_t terminal_words;
+    std::uint64_t label_bytes;
+
+    std::uint64_t total_words() const noexcept {
+      return sizeof(Header) / 8 + louds_words + rank_blocks + select_hints +
+             terminal_words + (label_bytes + 7) / 8;
+    }
+  };
+
+  std::vector<std::uint64_t> m_owned;
+  MappedFile m_file;
+
+  Header m_header{};
+  std::uint64_t const *m_louds{nullptr};
+  // Ones before each block, plus a final total
+  std::uint64_t const *m_ranks{nullptr};
+  // Block holding the (j * SELECT_SAMPLE)-th zero
+  std::uint64_t const *m_hints{nullptr};
+  std::uint64_t const *m_terminal{nullptr};
+  // Label of node j at j - 1; the root has none
+  unsigned char const *m_labels{nullptr};
+
+  static bool m_bit(std::uint64_t const *bits, std::size_t i) noexcept {
+    return (bits[i / 64] >> (i % 64)) & 1u;
+  }
+
+  static std::size_t m_select_in_word(std::uint64_t word, std::size_t r) noexcept {
+    std::size_t shift = 0;
+    for (auto c = static_cast<std::size_t>(std::popcount(word & 0xff)); r >= c;
+         c = static_cast<std::size_t>(std::popcount(word & 0xff))) {
+      r -= c;
+      word >>= 8;
+      shift += 8;
+    }
+    for (;; word >>= 1, ++shift) {
+      if (word & 1u) {
+        if (r == 0) {
+          return shift;
+        }
+        --r;
+      }
+    }
+  }
+
+  std::size_t m_zeros_before_block(std::size_t block) const noexcept {
+    return block * BLOCK_BITS - m_ranks[block];
+  }
+
+  /**
+   * @brief Position of the k-th zero (0-based) of the shape
+   */
+  std::size_t m_select0(std::size_t k) const noexcept {
+    std::size_t const sample = k / SELECT_SAMPLE;
+    std::size_t lo = m_hints[sample];
+    std::size_t hi = sample + 1 < m_header.select_hints ? m_hints[sample + 1] + 1
+                                                         : m_header.rank_blocks - 1;
+    // last block whose preceding zeros are at most k
+    while (hi - lo > 1) {
+      std::size_t const mid = lo + (hi - lo) / 2;
+      if (m_zeros_before_block(mid) <= k) {
+        lo = mid;
+      } else {
+        hi = mid;
+      }
+    }
+
+    std::size_t rest = k - m_zeros_before_block(lo);
+    std::size_t w = lo * BLOCK_WORDS;
+    for (;; ++w) {
+      auto const zeros = static_cast<std::size_t>(std::popcount(~m_louds[w]));
+      if (rest < zeros) {
+        break;
+      }
+      rest -= zeros;
+    }
+    return w * 64 + m_select_in_word(~m_louds[w], rest);
+  }
+
+  struct Children {
+    std::size_t first;
+    std::size_t count;
+  };
+
+  Children m_children(std::size_t node) const noexcept {
+    std::size_t const start = m_select0(node) + 1;
+    std::size_t count = 0;
+    for (std::size_t pos = start;;) {
+      std::size_t const offset = pos % 64;
+      auto const ones =
+          static_cast<std::size_t>(std::countr_one(m_louds[pos / 64] >> offset));
+      if (ones < 64 - offset) {
+        count += ones;
+        break;
+      }
+      count += 64 - offset;
+      pos += 64 - offset;
+    }
+    return {start - node - 1, count};
+  }
+
+  std::size_t m_child(std::size_t node, unsigned char label) const noexcept {
+    Children const c = m_children(node);
+    if (c.count == 0) {
+      return NONE;
+    }
+    auto const *labels = m_labels + c.first - 1;
+    auto const *hit =
+        static_cast<unsigned char const *>(std::memchr(labels, label, c.count));
+    return hit ? c.first + static_cast<std::size_t>(hit - labels) : NONE;
+  }
+
+  std::size_t m_walk(std::string_view key) const noexcept {
+    std::size_t node = 0;
+    for (char c : key) {
+      node = m_child(node, static_cast<unsigned char>(c));
+      if (node == NONE) {
+        return NONE;
+      }
+    }
+    return node;
+  }
+
+  void m_bind(std::uint64_t const *base, std::size_t words) {
+    if (words < sizeof(Header) / 8) {
+      throw std::runtime_error("Corrupt LOUDS trie!");
+    }
+    std::memcpy(&m_header, base, sizeof(Header));
+    // Bounding the node count first keeps the size arithmetic below from overflowing
+    if (m_header.magic != MAGIC || m_header.words != words || m_header.nodes == 0 ||
+        m_header.nodes > words * 8 || m_header.total_words() != words ||
+        m_header.louds_words != (m_header.louds_bits + 63) / 64 ||
+        m_header.rank_blocks !=
+            (m_header.louds_words + BLOCK_WORDS - 1) / BLOCK_WORDS + 1 ||
+        m_header.louds_bits != 2 * m_header.nodes + 1 ||
+        m_header.label_bytes + 1 != m_header.nodes ||
+        m_header.terminal_words != (m_header.nodes + 63) / 64 ||
+        m_header.select_hints != (m_header.nodes + SELECT_SAMPLE) / SELECT_SAMPLE) {
+      throw std::runtime_error("Corrupt LOUDS trie!");
+    }
+    m_louds = base + sizeof(Header) / 8;
+    m_ranks = m_louds + m_header.louds_words;
+    m_hints = m_ranks + m_header.rank_blocks;
+    m_terminal = m_hints + m_header.select_hints;
+    m_labels =
+        reinterpret_cast<unsigned char const *>(m_terminal + m_header.terminal_words);
+  }
+
+  /**
+   * @brief Check the directories of a mapped encoding against its bits, so that a
+   * corrupt file cannot send a query outside the arrays or around a cycle: the rank
+   * and select samples must match the shape, the shape must end in its last 0, and
+   * every node must be numbered after its parent.
+   */
+  void m_check() const {
+    std::uint64_t ones = 0;
+    std::uint64_t zeros = 0;
+    for (std::size_t i = 0; i < m_header.louds_bits; ++i) {
+      if (i % BLOCK_BITS == 0 && m_ranks[i / BLOCK_BITS] != ones) {
+        throw std::runtime_error("Corrupt LOUDS trie!");
+      }
+      if (m_bit(m_louds, i)) {
+        ++ones;
+        continue;
+      }
+      if (zeros % SELECT_SAMPLE == 0 &&
+          m_hints[zeros / SELECT_SAMPLE] != i / BLOCK_BITS) {
+        throw std::runtime_error("Corrupt LOUDS trie!");
+      }
+      // The children of node `zeros` follow this 0 and must already be counted
+      if (zeros < m_header.nodes && ones <= zeros) {
+        throw std::runtime_error("Corrupt LOUDS trie!");
+      }
+      ++zeros;
+    }
+
+    std::size_t const tail = m_header.louds_bits % 64;
+    std::size_t terminals = 0;
+    for (std::size_t w = 0; w < m_header.terminal_words; ++w) {
+      terminals += static_cast<std::size_t>(std::popcount(m_terminal[w]));
+    }
+    if (ones != m_header.nodes || m_ranks[m_header.rank_blocks - 1] != ones ||
+        m_bit(m_louds, m_header.louds_bits - 1) ||
+        (tail != 0 && m_louds[m_header.louds_words - 1] >> tail != 0) ||
+        (m_header.nodes % 64 != 0 &&
+         m_terminal[m_header.terminal_words - 1] >> (m_header.nodes % 64) != 0) ||
+        terminals != m_header.keys) {
+      throw std::runtime_error("Corrupt LOUDS trie!");
+    }
+  }
+
+  LoudsTrie() = default;
+
+public:
+  /** @brief Node index standing for "no node" */
+  static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+  /**
+   * @brief Encode the trie stored in `nodes`
+   *
+   * @param nodes The node pool of a Trie
+   */
+  explicit LoudsTrie(TrieNodePool const &nodes) {
+    std::vector<std::uint64_t> louds;
+    std::size_t bits = 0;
+    auto push_bit = [&](bool one) {
+      if (bits % 64 == 0) {
+        louds.push_back(0);
+      }
+      louds.back() |= std::uint64_t{one} << (bits % 64);
+      ++bits;
+    };
+
+    std::vector<std::uint64_t> terminal;
+    std::vector<unsigned char> labels;
+    std::vector<TrieNodePool::index_type> queue{TrieNodePool::ROOT};
+    queue.reserve(nodes.node_count());
+    std::uint64_t word_count = 0;
+
+    push_bit(true);
+    push_bit(false);
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      if (head % 64 == 0) {
+        terminal.push_back(0);
+      }
+      if (nodes.terminal(queue[head])) {
+        terminal.back() |= std::uint64_t{1} << (head % 64);
+        ++word_count;
+      }
+      nodes.for_each_child(queue[head],
+                           [&](std::uint8_t label, TrieNodePool::index_type child) {
+                             push_bit(true);
+                             labels.push_back(label);
+                             queue.push_back(child);
+                           });
+      push_bit(false);
+    }
+
+    std::vector<std::uint64_t> ranks;
+    std::uint64_t ones = 0;
+    for (std::size_t w = 0; w < louds.size(); ++w) {
+      if (w % BLOCK_WORDS == 0) {
+        ranks.push_back(ones);
+      }
+      ones += static_cast<std::uint64_t>(std::popcount(louds[w]));
+    }
+    ranks.push_back(ones);
+
+    std::vector<std::uint64_t> hints;
+    std::uint64_t zeros = 0;
+    for (std::size_t i = 0; i < bits; ++i) {
+      if (!m_bit(louds.data(), i)) {
+        if (zeros % SELECT_SAMPLE == 0) {
+          hints.push_back(i / BLOCK_BITS);
+        }
+        ++zeros;
+      }
+    }
+
+    Header header{.magic = MAGIC,
+                  .words = 0,
+                  .nodes = queue.size(),
+                  .keys = word_count,
+                  .louds_bits = bits,
+                  .louds_words = louds.size(),
+                  .rank_blocks = ranks.size(),
+                  .select_hints = hints.size(),
+                  .terminal_words = terminal.size(),
+                  .label_bytes = labels.size()};
+    header.words = header.total_words();
+
+    m_owned.assign(header.words, 0);
+    std::uint64_t *out = m_owned.data();
+    std::memcpy(out, &header, sizeof(Header));
+    out += sizeof(Header) / 8;
+    out = std::copy(louds.begin(), louds.end(), out);
+    out = std::copy(ranks.begin(), ranks.end(), out);
+    out = std::copy(hints.begin(), hints.end(), out);
+    out = std::copy(terminal.begin(), terminal.end(), out);
+    std::memcpy(out, labels.data(), labels.size());
+
+    m_bind(m_owned.data(), m_owned.size());
+  }
+
+  /**
+   * @brief Map a trie previously saved with write()
+   *
+   * @param path The file to map
+   * @return LoudsTrie A trie backed directly by the file's pages
+   * @throws std::runtime_error If the file cannot be mapped or is malformed
+   */
+  [[nodiscard]] static LoudsTrie open(std::filesystem::path const &path) {
+    LoudsTrie trie;
+    trie.m_file = MappedFile(path);
+    if (trie.m_file.size() % 8 != 0) {
+      throw std::runtime_error("Corrupt LOUDS trie!");
+    }
+    trie.m_bind(reinterpret_cast<std::uint64_t const *>(trie.m_file.data()),
+                trie.m_file.size() / 8);
+    trie.m_check();
+    return trie;
+  }
+
+  /**
+   * @brief Save the trie so that open() can map it. The file is written under a
+   * temporary name and renamed into place, so a trie at `path` is always complete.
+   *
+   * @param path The file to create
+   * @throws std::runtime_error If the file cannot be written
+   */
+  void write(std::filesystem::path const &path) const {
+    std::filesystem::path const tmp = path.string() + ".tmp";
+    std::error_code ec;
+    {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      out.write(reinterpret_cast<char const *>(m_louds) - sizeof(Header),
+                static_cast<std::streamsize>(m_header.words * 8));
+      out.close();
+      if (!out) {
+        ec = std::make_error_code(std::errc::io_error);
+      }
+    }
+    if (!ec) {
+      std::filesystem::rename(tmp, path, ec);
+    }
+    if (ec) {
+      std::filesystem::remove(tmp, ec);
+      throw std::runtime_error("Failed to write LOUDS trie!");
+    }
+  }
+
+  /**
+   * @brief Check if a word exists in the trie
+   *
+   * @param word The word to check for
+   * @return true If the word exists in the trie
+   * @return false If the word does not exist in the trie
+   */
+  [[nodiscard]] bool is_word(std::string_view word) const noexcept {
+    std::size_t const node = m_walk(word);
+    return node != NONE && m_bit(m_terminal, node);
+  }
+
+  /**
+   * @brief Check if any word in the trie starts with the given prefix
+   *
+   * @param prefix The prefix to check for
+   * @return true If the prefix exists in the trie
+   * @return false If no word in the trie starts with the prefix
+   */
+  [[nodiscard]] bool starts_with(std::string_view prefix) const noexcept {
+    return m_walk(prefix) != NONE;
+  }
+
+  /**
+   * @brief Call `f` with every word that starts with `prefix`, in lexicographic
+   * (byte) order. The string_view passed to `f` is only valid during the call.
+   *
+   * @param prefix The prefix to complete
+   * @param f Called as f(std::string_view word)
+   */
+  template <typename F>
+  void for_each_with_prefix(std::string_view prefix, F &&f) const {
+    std::size_t const start = m_walk(prefix);
+    if (start == NONE) {
+      return;
+    }
+
+    std::string word(prefix);
+    // (node, length of the word ending at node)
+    std::vector<std::pair<std::size_t, std::size_t>> stack{{start, prefix.size()}};
+    while (!stack.empty()) {
+      auto const [node, depth] = stack.back();
+      stack.pop_back();
+      if (node != start) {
+        word.resize(depth - 1);
+        word.push_back(static_cast<char>(m_labels[node - 1]));
+      }
+      if (m_bit(m_terminal, node)) {
+        f(std::string_view(word));
+      }
+      Children const c = m_children(node);
+      for (std::size_t i = c.count; i > 0; --i) {
+        stack.emplace_back(c.first + i - 1, depth + 1);
+      }
+    }
+  }
+
+  /**
+   * @brief Get the number of words in the trie
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return m_header.keys; }
+
+  /**
+   * @brief Get the number of nodes, including the root
+   */
+  [[nodiscard]] std::size_t node_count() const noexcept { return m_header.nodes; }
+
+  /**
+   * @brief Get the size of the encoding in bytes, which is also its file size
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept { return m_header.words * 8; }
+};
+
+} // namespace ming
+
+#endif // MING_LOUDS_TRIE
@@ -0,0 +1,150 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_MAPPED_FILE
+#define MING_MAPPED_FILE
+
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#define MING_MAPPED_FILE_NOMINMAX
+#endif
+#include <windows.h>
+#ifdef MING_MAPPED_FILE_NOMINMAX
+#undef NOMINMAX
+#undef MING_MAPPED_FILE_NOMINMAX
+#endif
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ming {
+
+/**
+ * @brief A read-only memory mapping of a whole file, through mmap on POSIX and
+ * MapViewOfFile on Windows. The mapping never moves, so pointers into it stay
+ * valid when the MappedFile is moved.
+ */
+class MappedFile {
+  char const *m_data{nullptr};
+  std::size_t m_size{0};
+
+public:
+  /**
+   * @brief An empty mapping
+   */
+  MappedFile() noexcept = default;
+
+  /**
+   * @brief Map `path` read-only
+   *
+   * @param path The file to map
+   * @throws std::runtime_error If the file cannot be opened or mapped, or is empty
+   */
+  explicit MappedFile(std::filesystem::path const &path) {
+#ifdef _WIN32
+    HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ,
+                                FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      throw std::runtime_error("Failed to open " + path.string() + "!");
+    }
+    LARGE_INTEGER size{};
+    if (!::GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+      ::CloseHandle(file);
+      throw std::runtime_error("Failed to open " + path.string() + "!");
+    }
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    // The view keeps the file and the mapping object alive after both handles close
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    void *mapped = mapping ? ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (mapping) {
+      ::CloseHandle(mapping);
+    }
+    if (!mapped) {
+      throw std::runtime_error("Failed to map " + path.string() + "!");
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open " + path.string() + "!");
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+      ::close(fd);
+      throw std::runtime_error("Failed to open " + path.string() + "!");
+    }
+    m_size = static_cast<std::size_t>(st.st_size);
+    void *mapped = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+      throw std::runtime_error("Failed to map " + path.string() + "!");
+    }
+#endif
+    m_data = static_cast<char const *>(mapped);
+  }
+
+  MappedFile(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile const &) = delete;
+
+  MappedFile(MappedFile &&other) noexcept
+      : m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)) {}
+
+  MappedFile &operator=(MappedFile &&other) noexcept {
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    return *this;
+  }
+
+  /**
+   * @brief Destructor; unmaps the file
+   */
+  ~MappedFile() noexcept {
+    if (m_data) {
+#ifdef _WIN32
+      ::UnmapViewOfFile(m_data);
+#else
+      ::munmap(const_cast<char *>(m_data), m_size);
+#endif
+    }
+  }
+
+  /**
+   * @brief Get the first byte of the mapping (page aligned)
+   */
+  [[nodiscard]] char const *data() const noexcept { return m_data; }
+
+  /**
+   * @brief Get the length of the mapping in bytes
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+};
+
+} // namespace ming
+
+#endif // MING_MAPPED_FILE
@@ -0,0 +1,217 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_RADIX_TRIE
+#define MING_RADIX_TRIE
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ming/trie_node_pool.hpp>
+
+namespace ming {
+
+/**
+ * @brief A path-compressed (radix / PATRICIA) trie with the same interface as Trie.
+ * Each edge carries a whole string segment rather than one character, so a node
+ * exists only where keys branch or end, and a chain of single-child nodes becomes
+ * one edge.
+ *
+ * The branching structure lives in a TrieNodePool, where a child is found by the
+ * first byte of its edge. The remaining bytes of every edge are kept in one shared
+ * buffer, referenced by offset and length.
+ *
+ * Keys are byte strings (std::string_view).
+ *
+ * @see https://dl.acm.org/doi/10.1145/321479.321481
+ */
+class RadixTrie {
+  using index_type = TrieNodePool::index_type;
+
+  /** @brief The label of the edge leading into a node, as a slice of m_labels */
+  struct Edge {
+    std::uint32_t offset{0};
+    std::uint32_t length{0};
+  };
+
+  TrieNodePool m_nodes;
+  std::vector<Edge> m_edges{Edge{}};
+  std::string m_labels;
+
+  std::string_view m_edge(index_type node) const noexcept {
+    Edge const e = m_edges[node];
+    return std::string_view(m_labels).substr(e.offset, e.length);
+  }
+
+  index_type m_create(Edge edge) {
+    index_type const node = m_nodes.create_node();
+    m_edges.push_back(edge);
+    return node;
+  }
+
+  Edge m_store(std::string_view segment) {
+    if (m_labels.size() + segment.size() > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::length_error("RadixTrie label storage is full!");
+    }
+    Edge const e{static_cast<std::uint32_t>(m_labels.size()),
+                 static_cast<std::uint32_t>(segment.size())};
+    m_labels.append(segment);
+    return e;
+  }
+
+  static unsigned char m_byte(char c) noexcept { return static_cast<unsigned char>(c); }
+
+  struct Match {
+    // The deepest node whose path is a prefix of the key
+    index_type node;
+    // How many bytes of the key were matched, including a partial match into the
+    // edge below `node`
+    std::size_t matched;
+    // Whether the match stopped exactly at `node` rather than part-way along an edge
+    bool at_node;
+  };
+
+  /**
+   * @brief Follow `key` from the root as far as it matches
+   */
+  Match m_walk(std::string_view key) const noexcept {
+    index_type node = TrieNodePool::ROOT;
+    std::size_t i = 0;
+    while (i < key.size()) {
+      index_type const next = m_nodes.child(node, m_byte(key[i]));
+      if (next == TrieNodePool::NONE) {
+        return {node, i, true};
+      }
+      std::string_view const edge = m_edge(next);
+      std::string_view const rest = key.substr(i);
+      if (rest.size() < edge.size()) {
+        return {node, edge.starts_with(rest) ? key.size() : i, false};
+      }
+      if (!rest.starts_with(edge)) {
+        return {node, i, true};
+      }
+      i += edge.size();
+      node = next;
+    }
+    return {node, i, true};
+  }
+
+public:
+  /**
+   * @brief Construct a new empty RadixTrie
+   */
+  RadixTrie() = default;
+
+  /**
+   * @brief Construct a RadixTrie with initial words
+   *
+   * @param list List of words to insert into the trie
+   */
+  RadixTrie(std::initializer_list<std::string_view> list) {
+    for (auto const &str : list) {
+      insert(str);
+    }
+  }
+
+  /**
+   * @brief Insert a word into the trie, splitting at most one edge
+   *
+   * @param word The word to insert
+   */
+  void insert(std::string_view word) {
+    index_type node = TrieNodePool::ROOT;
+    std::size_t i = 0;
+    while (i < word.size()) {
+      index_type const child = m_nodes.child(node, m_byte(word[i]));
+      if (child == TrieNodePool::NONE) {
+        index_type const leaf = m_create(m_store(word.substr(i)));
+        m_nodes.add_child(node, m_byte(word[i]), leaf);
+        m_nodes.set_terminal(leaf, true);
+        return;
+      }
+
+      std::string_view const edge = m_edge(child);
+      std::string_view const rest = word.substr(i);
+      auto const common = static_cast<std::size_t>(
+          std::ranges::mismatch(edge, rest).in1 - edge.begin());
+
+      if (common < edge.size()) {
+        // Split the edge: node -> middle (edge[0, common)) -> child (the rest)
+        Edge const e = m_edges[child];
+        index_type const middle =
+            m_create(Edge{e.offset, static_cast<std::uint32_t>(common)});
+        m_edges[child] = Edge{e.offset + static_cast<std::uint32_t>(common),
+                              e.length - static_cast<std::uint32_t>(common)};
+        m_nodes.replace_child(node, m_byte(word[i]), middle);
+        m_nodes.add_child(middle, m_byte(m_labels[m_edges[child].offset]), child);
+        node = middle;
+      } else {
+        node = child;
+      }
+      i += common;
+    }
+    m_nodes.set_terminal(node, true);
+  }
+
+  /**
+   * @brief Check if a word exists in the trie
+   *
+   * @param word The word to check for
+   * @return true If the word exists in the trie
+   * @return false If the word does not exist in the trie
+   */
+  [[nodiscard]] bool is_word(std::string_view word) const noexcept {
+    Match const m = m_walk(word);
+    return m.matched == word.size() && m.at_node && m_nodes.terminal(m.node);
+  }
+
+  /**
+   * @brief Check if any word in the trie starts with the given prefix
+   *
+   * @param prefix The prefix to check for
+   * @return true If the prefix exists in the trie
+   * @return false If no word in the trie starts with the prefix
+   */
+  [[nodiscard]] bool starts_with(std::string_view prefix) const noexcept {
+    return m_walk(prefix).matched == prefix.size();
+  }
+
+  /**
+   * @brief Get the number of nodes in the trie, including the root
+   */
+  [[nodiscard]] std::size_t node_count() const noexcept { return m_nodes.node_count(); }
+
+  /**
+   * @brief Get the number of bytes reserved for nodes and edge labels
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_nodes.memory_usage() + m_edges.capacity() * sizeof(Edge) +
+           m_labels.capacity();
+  }
+};
+
+} // namespace ming
+
+#endif // MING_RADIX_TRIE
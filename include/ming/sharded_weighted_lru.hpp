@@ -0,0 +1,245 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_SHARDED_WEIGHTED_LRU
+#define MING_SHARDED_WEIGHTED_LRU
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <ming/weighted_lru.hpp>
+
+namespace ming {
+
+/**
+ * @brief A thread-safe WeightedLRU split into independently locked shards
+ *
+ * Each key hashes to one of a power-of-two number of shards, and each shard is a
+ * WeightedLRU with an equal part of the total weight budget, guarded by its own
+ * reader-writer lock. Lookups only take the lock shared, so readers of a shard run
+ * in parallel: instead of moving the entry to the front of the recency list, a
+ * lookup appends its handle to the shard's read buffer with one atomic increment.
+ * The reader whose write completes the buffer replays it in order while still
+ * holding the lock shared, under a second mutex that guards only the eviction
+ * policy; find() and value() never read the policy, and put() replays what is
+ * recorded under the exclusive lock first, so eviction always sees every recorded
+ * read. Reads that arrive during a replay are dropped, which makes recency
+ * approximate under heavy read load but never blocks a reader behind a writer (the
+ * approach of Caffeine's read buffers).
+ *
+ * @see https://github.com/ben-manes/caffeine/wiki/Design
+ *
+ * @tparam K The key type; hashed with std::hash<K>
+ * @tparam V The value type
+ * @tparam Policy Each shard's eviction policy; see EvictionPolicy
+ */
+template <typename K, typename V, EvictionPolicy Policy = LRUPolicy>
+class ShardedWeightedLRU {
+  using Cache = WeightedLRU<K, V, Policy>;
+  using handle_type = typename Cache::handle_type;
+
+  /** @brief How many reads a shard records between replays */
+  static constexpr std::uint32_t READ_BUFFER = 64;
+
+  struct alignas(64) Shard {
+    std::shared_mutex mutex;
+    Cache cache;
+    /** @brief Guards the policy while a reader replays the buffer */
+    std::mutex policy_mutex;
+    /** @brief Buffer positions claimed, including those of dropped reads */
+    std::atomic<std::uint32_t> reads{0};
+    /** @brief Buffer positions whose handle has been stored */
+    std::atomic<std::uint32_t> written{0};
+    std::array<std::atomic<handle_type>, READ_BUFFER> buffer;
+
+    Shard() : cache(0) {}
+
+    /**
+     * @brief Record a read of `e`, replaying the buffer if this read completes it.
+     * Shared lock held.
+     */
+    void record(handle_type e) noexcept {
+      // Acquire: a position reopened by a replay is only written after it is read
+      std::uint32_t const n = reads.fetch_add(1, std::memory_order_acquire);
+      if (n >= READ_BUFFER) {
+        return;
+      }
+      buffer[n].store(e, std::memory_order_relaxed);
+      // Only the last of the buffer's writers sees every handle stored
+      if (written.fetch_add(1, std::memory_order_acq_rel) + 1 == READ_BUFFER) {
+        {
+          // Uncontended: the previous replay released it before reopening the
+          // buffer, and put() excludes readers altogether
+          std::lock_guard lock(policy_mutex);
+          replay(READ_BUFFER);
+        }
+        written.store(0, std::memory_order_relaxed);
+        reads.store(0, std::memory_order_release);
+      }
+    }
+
+    /**
+     * @brief Apply the first `n` recorded reads to the eviction order. Exclusive
+     * lock, or the shared lock and policy_mutex, held.
+     */
+    void replay(std::uint32_t n) noexcept {
+      for (std::uint32_t i = 0; i < n; ++i) {
+        cache.touch(buffer[i].load(std::memory_order_relaxed));
+      }
+    }
+
+    /**
+     * @brief Apply the recorded reads to the eviction order. Exclusive lock held.
+     */
+    void drain() noexcept {
+      replay(written.load(std::memory_order_relaxed));
+      written.store(0, std::memory_order_relaxed);
+      reads.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  std::unique_ptr<Shard[]> m_shards;
+  std::size_t m_shard_bits;
+  int m_capacity;
+
+  Shard &m_shard(K const &key) const noexcept {
+    // A different multiplier from WeightedLRU's, so that the keys of one shard
+    // still spread over its whole index
+    auto const h = static_cast<std::uint64_t>(std::hash<K>{}(key));
+    std::size_t const i =
+        m_shard_bits ? static_cast<std::size_t>((h * 0xbf58476d1ce4e5b9ULL) >>
+                                                (64 - m_shard_bits))
+                     : 0;
+    return m_shards[i];
+  }
+
+  static std::size_t m_validate_shards(std::size_t shards) {
+    if (shards == 0 || !std::has_single_bit(shards)) {
+      throw std::invalid_argument("Shard count must be a power of two!");
+    }
+    return shards;
+  }
+
+public:
+  /**
+   * @brief Construct an empty cache
+   *
+   * @param capacity The largest total weight; each shard gets capacity / shards
+   * @param shards The number of shards; a power of two
+   * @throws std::invalid_argument If `shards` is not a power of two
+   */
+  explicit ShardedWeightedLRU(int capacity, std::size_t shards = 16)
+      : m_shard_bits(static_cast<std::size_t>(
+            std::countr_zero(m_validate_shards(shards)))),
+        m_capacity(capacity) {
+    int const budget = capacity / static_cast<int>(shards);
+    m_shards = std::make_unique<Shard[]>(shards);
+    for (std::size_t i = 0; i < shards; ++i) {
+      m_shards[i].cache = Cache(budget);
+    }
+  }
+
+  ShardedWeightedLRU(ShardedWeightedLRU const &) = delete;
+  ShardedWeightedLRU &operator=(ShardedWeightedLRU const &) = delete;
+
+  /**
+   * @brief Look up a key, recording the access for the shard's next replay
+   *
+   * @param key The key to look up
+   * @return std::expected<V, std::string> A copy of the value, or an error if the
+   * key is not cached
+   */
+  std::expected<V, std::string> get(K const &key) {
+    Shard &shard = m_shard(key);
+    std::shared_lock shared(shard.mutex);
+    handle_type const e = shard.cache.find(key);
+    if (e == Cache::NOT_CACHED) {
+      return std::unexpected{"No such key!"};
+    }
+    std::expected<V, std::string> result(shard.cache.value(e));
+    shard.record(e);
+    return result;
+  }
+
+  /**
+   * @brief Insert or update an entry in its shard, evicting the entries that
+   * shard's policy picks until its weight fits
+   *
+   * @param key The key
+   * @param value The value
+   * @param size The entry's weight
+   * @throws std::runtime_error If `size` exceeds a shard's capacity
+   */
+  void put(K key, V value, int size) {
+    Shard &shard = m_shard(key);
+    std::unique_lock lock(shard.mutex);
+    shard.drain();
+    shard.cache.put(std::move(key), std::move(value), size);
+  }
+
+  /**
+   * @brief Get the number of cached entries, summed over the shards
+   */
+  [[nodiscard]] std::size_t size() const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < shard_count(); ++i) {
+      std::shared_lock lock(m_shards[i].mutex);
+      total += m_shards[i].cache.size();
+    }
+    return total;
+  }
+
+  /**
+   * @brief Get the total weight of the cached entries, summed over the shards
+   */
+  [[nodiscard]] int weight() const {
+    int total = 0;
+    for (std::size_t i = 0; i < shard_count(); ++i) {
+      std::shared_lock lock(m_shards[i].mutex);
+      total += m_shards[i].cache.weight();
+    }
+    return total;
+  }
+
+  /**
+   * @brief Get the total weight budget
+   */
+  [[nodiscard]] int capacity() const noexcept { return m_capacity; }
+
+  /**
+   * @brief Get the number of shards
+   */
+  [[nodiscard]] std::size_t shard_count() const noexcept {
+    return std::size_t{1} << m_shard_bits;
+  }
+};
+
+} // namespace ming
+
+#endif // MING_SHARDED_WEIGHTED_LRU
@@ -19,14 +19,39 @@
 #ifndef MING_SKIPLIST
 #define MING_SKIPLIST
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <memory>
+#include <iterator>
+#include <new>
+#include <optional>
 #include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace ming {
 
+/**
+ * @brief Tuning knobs for a SkipList
+ */
+struct SkipListOptions {
+  // Probability that a tower grows one more level; must be 1/2, 1/4, ..., 1/65536.
+  // Smaller values mean fewer links per node but longer horizontal walks.
+  double probability = 0.5;
+  // Tallest tower that will be generated; 0 means the list type's MaxLevel
+  int max_level = 0;
+  // Seed for tower heights; unseeded lists draw one from std::random_device
+  std::optional<std::uint64_t> seed = std::nullopt;
+};
+
 /**
  * @brief A probabilistic data structure that allows O(log n) search complexity
  * and O(log n) insertion complexity within an ordered sequence
@@ -36,32 +61,96 @@ namespace ming {
  * @tparam Key The key type used for comparison and ordering
  * @tparam T The value type stored in the skip list
  * @tparam Compare The comparison function type
+ * @tparam MaxLevel Upper bound on tower height, fixing the size of the head tower
+ * and of the search path kept on the stack
  */
-template <typename Key, typename T, typename Compare = std::less<Key>>
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          int MaxLevel = 32>
 class SkipList {
+  static_assert(MaxLevel >= 1 && MaxLevel <= 64, "MaxLevel must be within [1, 64]");
+
 private:
-  static constexpr int MAX_LEVEL = 32; // for now...
+  static constexpr int MAX_LEVEL = MaxLevel;
+
+  /**
+   * @brief Links cache a hint of their target's key so that most comparisons on
+   * the search path never dereference the successor. Small trivially copyable
+   * keys are cached verbatim; std::string keys under lexicographic ordering cache
+   * an order-preserving 8-byte prefix and only fall back to the full key on a tie.
+   */
+  static constexpr bool COPY_HINT =
+      std::is_trivially_copyable_v<Key> && sizeof(Key) <= sizeof(void *);
+
+  static constexpr bool PREFIX_HINT =
+      !COPY_HINT && std::is_same_v<Key, std::string> &&
+      (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>>);
+
+  struct NoHint {};
+
+  using hint_type =
+      std::conditional_t<COPY_HINT, Key,
+                         std::conditional_t<PREFIX_HINT, std::uint64_t, NoHint>>;
+
+  struct Node;
 
-  // Probability factor for level generation (kinda textbook definition)
-  static constexpr float P = 0.5f;
+  /**
+   * @brief A forward pointer together with its span: the number of level-0 steps
+   * it skips. Summing widths along a search path yields a node's position, where
+   * the head is position 0 and a null link points at position size() + 1.
+   */
+  struct Link {
+    Node *node{nullptr};
+    std::size_t width{1};
+    [[no_unique_address]] hint_type hint{};
+  };
 
-  struct Node {
+  /**
+   * @brief A tower is allocated as one block: the node header immediately followed
+   * by its `level` links, so descending a level stays within the same node. The
+   * alignment is spelled as one alignas because GCC 12 keeps only the last of
+   * several dependent ones.
+   */
+  struct alignas(std::max({alignof(Link), alignof(Key), alignof(T)})) Node {
     Key key;
     T value;
-    // Each node owns itself through shared_ptr references from predecessors at each
-    // level. Forward pointers are shared_ptr so multiple levels can reference the same
-    // node safely.
-    std::vector<std::shared_ptr<Node>> forward;
+    int level;
+
+    template <typename K, typename... Args>
+    Node(int lvl, K &&k, Args &&...args)
+        : key(std::forward<K>(k)), value(std::forward<Args>(args)...), level(lvl) {}
 
-    Node(Key const &k, T const &v, int level)
-        : key(k), value(v), forward(static_cast<size_t>(level)) {}
+    Link *forward() noexcept {
+      return std::launder(reinterpret_cast<Link *>(this + 1));
+    }
+
+    Link const *forward() const noexcept {
+      return std::launder(reinterpret_cast<Link const *>(this + 1));
+    }
+
+    template <typename K, typename... Args>
+    static Node *create(int lvl, K &&k, Args &&...args) {
+      void *mem = ::operator new(sizeof(Node) + sizeof(Link) * static_cast<size_t>(lvl),
+                                 std::align_val_t{alignof(Node)});
+      Node *n = nullptr;
+      try {
+        n = new (mem) Node(lvl, std::forward<K>(k), std::forward<Args>(args)...);
+      } catch (...) {
+        ::operator delete(mem, std::align_val_t{alignof(Node)});
+        throw;
+      }
+      for (int i = 0; i < lvl; ++i) {
+        new (n->forward() + i) Link{};
+      }
+      return n;
+    }
 
-    Node(Key &&k, T &&v, int level)
-        : key(std::move(k)), value(std::move(v)), forward(static_cast<size_t>(level)) {}
+    static void destroy(Node *n) noexcept {
+      n->~Node();
+      ::operator delete(static_cast<void *>(n), std::align_val_t{alignof(Node)});
+    }
   };
 
-  using node_ptr = std::shared_ptr<Node>;
-  node_ptr m_head;
+  Node *m_head;
 
   int m_level;
 
@@ -69,94 +158,728 @@ private:
 
   Compare m_compare;
 
-  std::mt19937 m_gen;
-  std::uniform_real_distribution<float> m_dis;
+  // Tower heights are capped here, at most MAX_LEVEL
+  int m_max_level;
+
+  // log2(1 / probability): random bits consumed per level
+  int m_bits_per_level;
+
+  std::uint64_t m_rng;
+
+  /**
+   * @brief splitmix64; any seed, including 0, gives a full-period sequence
+   */
+  std::uint64_t m_next_random() noexcept {
+    std::uint64_t z = (m_rng += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
 
+  /**
+   * @brief Draw a tower height from one random word: each run of
+   * `m_bits_per_level` trailing zero bits is one more level, which happens with
+   * probability 2^-m_bits_per_level
+   */
   int get_random_level() noexcept {
-    int generated_level = 1;
-    while (m_dis(m_gen) < P && generated_level < MAX_LEVEL)
-      ++generated_level;
-    return generated_level;
+    return m_level_for(std::countr_zero(m_next_random()));
+  }
+
+  int m_level_for(int zeros) const noexcept {
+    return std::min(m_max_level, 1 + zeros / m_bits_per_level);
+  }
+
+  static int m_validate_bits(double probability) {
+    for (int bits = 1; bits <= 16; ++bits) {
+      if (probability == 1.0 / static_cast<double>(1u << bits)) {
+        return bits;
+      }
+    }
+    throw std::invalid_argument("SkipList probability must be 1/2, 1/4, ..., 1/65536!");
+  }
+
+  static int m_validate_max_level(int max_level) {
+    if (max_level == 0) {
+      return MAX_LEVEL;
+    }
+    if (max_level < 1 || max_level > MAX_LEVEL) {
+      throw std::invalid_argument("SkipList max_level is out of range!");
+    }
+    return max_level;
+  }
+
+  /**
+   * @brief Options that reproduce this list's level generation from its current
+   * random state onwards
+   */
+  SkipListOptions m_options() const noexcept {
+    return {1.0 / static_cast<double>(1u << m_bits_per_level), m_max_level, m_rng};
+  }
+
+  static std::uint64_t m_seed(std::optional<std::uint64_t> seed) {
+    if (seed) {
+      return *seed;
+    }
+    std::random_device rd;
+    return (std::uint64_t{rd()} << 32) | rd();
+  }
+
+  static void m_prefetch([[maybe_unused]] void const *p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#endif
+  }
+
+  static std::uint64_t m_prefix(std::string_view s) noexcept {
+    std::uint64_t prefix = 0;
+    std::size_t const n = std::min<std::size_t>(s.size(), sizeof(prefix));
+    for (std::size_t i = 0; i < n; ++i) {
+      prefix |= std::uint64_t{static_cast<unsigned char>(s[i])} << (56 - 8 * i);
+    }
+    return prefix;
+  }
+
+  /**
+   * @brief Point `link` at `node` and refresh the cached key hint
+   */
+  static void m_point(Link &link, Node *node, std::size_t width) noexcept {
+    link.node = node;
+    link.width = width;
+    if constexpr (COPY_HINT) {
+      if (node) {
+        link.hint = node->key;
+      }
+    } else if constexpr (PREFIX_HINT) {
+      link.hint = node ? m_prefix(node->key) : 0;
+    }
+  }
+
+  /**
+   * @brief A search key together with its hint, computed once per search
+   */
+  template <typename K>
+  struct Probe {
+    static constexpr bool USES_PREFIX =
+        PREFIX_HINT && std::is_convertible_v<K const &, std::string_view>;
+
+    K const &key;
+    std::uint64_t prefix;
+
+    explicit Probe(K const &k) noexcept : key(k), prefix(0) {
+      if constexpr (USES_PREFIX) {
+        prefix = m_prefix(std::string_view(k));
+      }
+    }
+  };
+
+  /**
+   * @brief Whether the (non-null) target of `link` is ordered before the probe key
+   */
+  template <typename K>
+  bool m_before(Link const &link, Probe<K> const &probe) const noexcept {
+    if constexpr (COPY_HINT) {
+      return m_compare(link.hint, probe.key);
+    } else if constexpr (Probe<K>::USES_PREFIX) {
+      if (link.hint != probe.prefix) {
+        return link.hint < probe.prefix;
+      }
+    }
+    return m_compare(link.node->key, probe.key);
+  }
+
+  /**
+   * @brief Whether the (non-null) target of `link` is not ordered after the probe
+   * key
+   */
+  template <typename K>
+  bool m_not_after(Link const &link, Probe<K> const &probe) const noexcept {
+    if constexpr (COPY_HINT) {
+      return !m_compare(probe.key, link.hint);
+    } else if constexpr (Probe<K>::USES_PREFIX) {
+      if (link.hint != probe.prefix) {
+        return link.hint < probe.prefix;
+      }
+    }
+    return !m_compare(probe.key, link.node->key);
   }
 
   /**
    * @brief Descend along a given level with bounds + key comparison checks. Walk
-   * forward while next node exists and key(next) < target key.
+   * forward while next node exists and key(next) < target key. The successor of
+   * each node visited is prefetched while its hint is being compared.
    *
    * @param node The current node to descend from
    * @param level The level to descend at
-   * @param key The target key to compare against
+   * @param probe The target key to compare against
    * @return The last node encountered before the target key
    */
-  Node *m_descend(Node *node, int level, Key const &key) const noexcept {
-    while (level < static_cast<int>(node->forward.size()) && node->forward[level] &&
-           m_compare(node->forward[level]->key, key)) {
-      node = node->forward[level].get();
+  template <typename K>
+  Node *m_descend(Node *node, int level, Probe<K> const &probe) const noexcept {
+    Link const *link = node->forward() + level;
+    while (link->node && m_before(*link, probe)) {
+      node = link->node;
+      link = node->forward() + level;
+      m_prefetch(link->node);
+    }
+    if (level > 0) {
+      m_prefetch(link[-1].node);
     }
     return node;
   }
 
-public:
   /**
-   * @brief Construct a new SkipList object
+   * @brief Same as m_descend, additionally accumulating the widths of the links
+   * taken into `position`
+   *
+   * @param node The current node to descend from
+   * @param level The level to descend at
+   * @param probe The target key to compare against
+   * @param position Position of `node`, advanced to that of the returned node
+   * @return The last node encountered before the target key
    */
-  SkipList()
-      : m_head(std::make_shared<Node>(Key{}, T{}, MAX_LEVEL)), m_level(1), m_size(0),
-        m_compare(Compare{}), m_gen(std::random_device{}()), m_dis(0.0, 1.0) {}
+  template <typename K>
+  Node *m_descend(Node *node, int level, Probe<K> const &probe,
+                  std::size_t &position) const noexcept {
+    Link const *link = node->forward() + level;
+    while (link->node && m_before(*link, probe)) {
+      position += link->width;
+      node = link->node;
+      link = node->forward() + level;
+      m_prefetch(link->node);
+    }
+    if (level > 0) {
+      m_prefetch(link[-1].node);
+    }
+    return node;
+  }
 
   /**
-   * @brief Construct a new SkipList with custom comparator
+   * @brief Unlink `target` given its predecessor at every active level, keeping
+   * the widths of the links that jump over it consistent, and free it
    *
-   * @param comp The comparison function object
+   * @param target The node to unlink
+   * @param update The rightmost node before `target` at each level
    */
-  explicit SkipList(Compare comp)
-      : m_head(std::make_shared<Node>(Key{}, T{}, MAX_LEVEL)), m_level(1), m_size(0),
-        m_compare(std::move(comp)), m_gen(std::random_device{}()), m_dis(0.0, 1.0) {}
+  void m_unlink(Node *target, Node *const *update) noexcept {
+    for (int i = 0; i < m_level; i++) {
+      Link &link = update[i]->forward()[i];
+      if (link.node == target) {
+        Link const &next = target->forward()[i];
+        link.node = next.node;
+        link.width += next.width - 1;
+        link.hint = next.hint;
+      } else {
+        link.width -= 1;
+      }
+    }
+    Node::destroy(target);
+
+    // Update the level if needed
+    while (m_level > 1 && !m_head->forward()[m_level - 1].node) {
+      m_level--;
+    }
+
+    m_size--;
+  }
 
   /**
-   * @brief Insert a key-value pair into the skiplist
+   * @brief Find the node for `key`, or create it from `args` if there is none. The
+   * search path lives in fixed-size arrays on the stack, so the only allocation
+   * is the new node itself.
    *
-   * @param key The key
-   * @param value The value
-   * @return true If inserted successfully
-   * @return false If not inserted (e.g., duplicate key)
+   * @param key The key to look up, forwarded into the node only on insertion
+   * @param args Arguments to construct the value from, untouched if `key` exists
+   * @return std::pair<Node *, bool> The node for `key` and whether it was created
    */
-  bool insert(Key const &key, T const &value) {
-    std::vector<Node *> update(MAX_LEVEL);
-    Node *current = m_head.get();
+  template <typename K, typename... Args>
+  std::pair<Node *, bool> m_try_emplace(K &&key, Args &&...args) {
+    Node *update[MAX_LEVEL];
+    std::size_t position[MAX_LEVEL];
+    Probe<std::remove_cvref_t<K>> const probe(key);
+    Node *current = m_head;
+    std::size_t pos = 0;
 
     // Find the position to insert at each level (top-down)
     for (int i = m_level - 1; i >= 0; --i) {
-      current = m_descend(current, i, key);
+      current = m_descend(current, i, probe, pos);
       update[i] = current;
+      position[i] = pos;
     }
 
-    current = (!current->forward.empty()) ? current->forward[0].get() : nullptr;
+    current = current->forward()[0].node;
 
     // Reject duplicate key (no insertion performed)
-    if (current && !m_compare(current->key, key) && !m_compare(key, current->key)) {
-      return false;
+    if (current && !m_compare(key, current->key)) {
+      return {current, false};
     }
 
     int new_level = get_random_level();
 
     if (new_level > m_level) {
       for (int i = m_level; i < new_level; i++) {
-        update[i] = m_head.get();
+        update[i] = m_head;
+        position[i] = 0;
+        m_head->forward()[i].width = m_size + 1;
       }
       m_level = new_level;
     }
 
-    auto new_node = std::make_shared<Node>(key, value, new_level);
+    Node *new_node =
+        Node::create(new_level, std::forward<K>(key), std::forward<Args>(args)...);
+    std::size_t const new_pos = position[0] + 1;
 
     // Insert node at the appropriate position at every level
     for (int i = 0; i < new_level; i++) {
-      new_node->forward[i] = update[i]->forward[i];
-      update[i]->forward[i] = new_node; // share ownership
+      Link &link = update[i]->forward()[i];
+      new_node->forward()[i] = link;
+      new_node->forward()[i].width = link.width + position[i] + 1 - new_pos;
+      m_point(link, new_node, new_pos - position[i]);
+    }
+
+    // Links above the new tower now jump over one more node
+    for (int i = new_level; i < m_level; i++) {
+      update[i]->forward()[i].width += 1;
     }
 
     m_size++;
-    return true;
+    return {new_node, true};
+  }
+
+  /**
+   * @brief Seek the first node whose key is not less than `key`
+   *
+   * @param key The key to seek to
+   * @return The first node not ordered before `key`, or nullptr if there is none
+   */
+  template <typename K>
+  Node *m_lower_bound(K const &key) const noexcept {
+    Probe<K> const probe(key);
+    Node *current = m_head;
+    for (int i = m_level - 1; i >= 0; --i) {
+      current = m_descend(current, i, probe);
+    }
+    return current->forward()[0].node;
+  }
+
+  /**
+   * @brief Locate the node with a key equivalent to `key`
+   *
+   * @param key The key to look for
+   * @return The matching node, or nullptr if there is none
+   */
+  template <typename K>
+  Node *m_find(K const &key) const noexcept {
+    Node *current = m_lower_bound(key);
+    return (current && !m_compare(key, current->key)) ? current : nullptr;
+  }
+
+  /**
+   * @brief Seek the first node whose key is ordered after `key`
+   *
+   * @param key The key to seek past
+   * @return The first node ordered after `key`, or nullptr if there is none
+   */
+  Node *m_upper_bound(Key const &key) const noexcept {
+    Probe<Key> const probe(key);
+    Node *current = m_head;
+    for (int i = m_level - 1; i >= 0; --i) {
+      Link const *link = current->forward() + i;
+      while (link->node && m_not_after(*link, probe)) {
+        current = link->node;
+        link = current->forward() + i;
+      }
+    }
+    return current->forward()[0].node;
+  }
+
+  /**
+   * @brief Links nodes supplied in ascending key order to the right end of a
+   * list, one tower at a time, so a whole list is built in a single O(n) pass
+   */
+  struct Appender {
+    Node *tails[MAX_LEVEL];
+    std::size_t positions[MAX_LEVEL]{};
+    std::size_t count{0};
+    int level{1};
+
+    explicit Appender(Node *head) noexcept {
+      for (auto &tail : tails) {
+        tail = head;
+      }
+    }
+
+    void append(Node *node) noexcept {
+      ++count;
+      for (int i = 0; i < node->level; ++i) {
+        m_point(tails[i]->forward()[i], node, count - positions[i]);
+        tails[i] = node;
+        positions[i] = count;
+      }
+      node->forward()[0].node = nullptr;
+      level = std::max(level, node->level);
+    }
+
+    void finish() noexcept {
+      for (int i = 0; i < MAX_LEVEL; ++i) {
+        m_point(tails[i]->forward()[i], nullptr, count + 1 - positions[i]);
+      }
+    }
+  };
+
+  void m_adopt(Appender &appender) noexcept {
+    appender.finish();
+    m_level = appender.level;
+    m_size = appender.count;
+  }
+
+  /**
+   * @brief Detach every node from the list, in order, leaving an empty list. The
+   * nodes' links are left stale; an Appender rewrites all of them.
+   *
+   * @param nodes Receives the former elements; its capacity must already hold
+   * size() more, so detaching cannot fail part-way
+   */
+  void m_detach(std::vector<Node *> &nodes) noexcept {
+    for (Node *n = m_head->forward()[0].node; n; n = n->forward()[0].node) {
+      nodes.push_back(n);
+    }
+    m_reset_head();
+  }
+
+  void m_reset_head() noexcept {
+    for (int i = 0; i < MAX_LEVEL; ++i) {
+      m_head->forward()[i] = Link{};
+    }
+    m_level = 1;
+    m_size = 0;
+  }
+
+public:
+  class iterator;
+
+  /**
+   * @brief How bulk construction assigns tower heights
+   */
+  enum class LevelAssignment {
+    // Draw each height from the same distribution as insert()
+    random,
+    // The i-th node (1-based) gets 1 + countr_zero(i) / log2(1 / probability)
+    // levels, a perfectly balanced list that is also reproducible
+    balanced,
+  };
+
+  /**
+   * @brief Construct a new SkipList object
+   */
+  SkipList() : SkipList(SkipListOptions{}) {}
+
+  /**
+   * @brief Construct a new SkipList with custom comparator
+   *
+   * @param comp The comparison function object
+   */
+  explicit SkipList(Compare comp) : SkipList(SkipListOptions{}, std::move(comp)) {}
+
+  /**
+   * @brief Construct a new SkipList with custom level generation
+   *
+   * @param options Branching probability, height cap and optional seed
+   * @param comp The comparison function object
+   * @throws std::invalid_argument If the probability or max level is unsupported
+   */
+  explicit SkipList(SkipListOptions const &options, Compare comp = Compare{})
+      : m_head(nullptr), m_level(1), m_size(0), m_compare(std::move(comp)),
+        m_max_level(m_validate_max_level(options.max_level)),
+        m_bits_per_level(m_validate_bits(options.probability)),
+        m_rng(m_seed(options.seed)) {
+    m_head = Node::create(MAX_LEVEL, Key{}, T{});
+  }
+
+  /**
+   * @brief Destructor; releases the nodes iteratively, front to back
+   */
+  ~SkipList() noexcept {
+    if (m_head) {
+      clear();
+      Node::destroy(m_head);
+    }
+  }
+
+  /**
+   * @brief Copy constructor; rebuilds the list in one pass, keeping tower heights
+   *
+   * @param other SkipList to copy from
+   */
+  SkipList(SkipList const &other) : SkipList(other.m_options(), other.m_compare) {
+    Appender appender(m_head);
+    for (Node *n = other.m_head->forward()[0].node; n; n = n->forward()[0].node) {
+      appender.append(Node::create(n->level, n->key, n->value));
+    }
+    m_adopt(appender);
+  }
+
+  /**
+   * @brief Move constructor
+   *
+   * @param other SkipList to move from
+   */
+  SkipList(SkipList &&other) noexcept
+      : m_head(std::exchange(other.m_head, nullptr)), m_level(other.m_level),
+        m_size(std::exchange(other.m_size, 0)), m_compare(std::move(other.m_compare)),
+        m_max_level(other.m_max_level), m_bits_per_level(other.m_bits_per_level),
+        m_rng(other.m_rng) {}
+
+  /**
+   * @brief Copy assignment operator
+   *
+   * @param other SkipList to copy from
+   * @return SkipList& Reference to this object
+   */
+  SkipList &operator=(SkipList const &other) {
+    if (this == &other) {
+      return *this;
+    }
+    return *this = SkipList(other);
+  }
+
+  /**
+   * @brief Move assignment operator
+   *
+   * @param other SkipList to move from
+   * @return SkipList& Reference to this object
+   */
+  SkipList &operator=(SkipList &&other) noexcept {
+    std::swap(m_head, other.m_head);
+    std::swap(m_level, other.m_level);
+    std::swap(m_size, other.m_size);
+    std::swap(m_compare, other.m_compare);
+    std::swap(m_max_level, other.m_max_level);
+    std::swap(m_bits_per_level, other.m_bits_per_level);
+    std::swap(m_rng, other.m_rng);
+    return *this;
+  }
+
+  /**
+   * @brief Build a skiplist from key-value pairs sorted by `comp` in O(n), linking
+   * towers left to right without any search. Later duplicates of a key are
+   * ignored, as with insert().
+   *
+   * @param first Iterator to the first pair
+   * @param last Sentinel for the end of the input
+   * @param levels How tower heights are assigned
+   * @param comp The comparison function object
+   * @param options Branching probability, height cap and optional seed
+   * @return SkipList The populated skiplist
+   * @throws std::invalid_argument If the input is not sorted
+   */
+  template <std::input_iterator It, std::sentinel_for<It> S>
+  [[nodiscard]] static SkipList
+  from_sorted(It first, S last, LevelAssignment levels = LevelAssignment::random,
+              Compare comp = Compare{}, SkipListOptions const &options = {}) {
+    SkipList list(options, std::move(comp));
+    Appender appender(list.m_head);
+    Node *prev = nullptr;
+
+    for (; first != last; ++first) {
+      // Elements are moved from when the input yields rvalues
+      auto &&elem = *first;
+      auto const &key = std::get<0>(elem);
+      if (prev && !list.m_compare(prev->key, key)) {
+        if (list.m_compare(key, prev->key)) {
+          throw std::invalid_argument("SkipList::from_sorted input is not sorted!");
+        }
+        continue;
+      }
+
+      int const height = levels == LevelAssignment::balanced
+                             ? list.m_level_for(std::countr_zero(appender.count + 1))
+                             : list.get_random_level();
+
+      Node *node = Node::create(height, std::get<0>(std::forward<decltype(elem)>(elem)),
+                                std::get<1>(std::forward<decltype(elem)>(elem)));
+      prev = node;
+      appender.append(node);
+    }
+
+    list.m_adopt(appender);
+    return list;
+  }
+
+  /**
+   * @brief Build a skiplist from a range of key-value pairs sorted by `comp`
+   *
+   * @param input The sorted pairs
+   * @param levels How tower heights are assigned
+   * @param comp The comparison function object
+   * @param options Branching probability, height cap and optional seed
+   * @return SkipList The populated skiplist
+   */
+  template <std::ranges::input_range R>
+  [[nodiscard]] static SkipList
+  from_sorted(R &&input, LevelAssignment levels = LevelAssignment::random,
+              Compare comp = Compare{}, SkipListOptions const &options = {}) {
+    return from_sorted(std::ranges::begin(input), std::ranges::end(input), levels,
+                       std::move(comp), options);
+  }
+
+  /**
+   * @brief Remove all elements
+   */
+  void clear() noexcept {
+    if (!m_head) {
+      return;
+    }
+
+    Node *node = m_head->forward()[0].node;
+    while (node) {
+      Node *next = node->forward()[0].node;
+      Node::destroy(node);
+      node = next;
+    }
+    m_reset_head();
+  }
+
+  /**
+   * @brief Move every element of `other` whose key is not already present into
+   * this skiplist in O(n + m). Both lists are relinked in a single merge pass,
+   * nodes keep their tower heights and no element is copied. Elements with
+   * duplicate keys stay in `other`.
+   *
+   * @param other The skiplist to merge from
+   */
+  void merge(SkipList &other) {
+    if (this == &other) {
+      return;
+    }
+
+    std::vector<Node *> mine;
+    std::vector<Node *> theirs;
+    mine.reserve(m_size);
+    theirs.reserve(other.m_size);
+    m_detach(mine);
+    other.m_detach(theirs);
+    Appender kept(m_head);
+    Appender rejected(other.m_head);
+
+    auto a = mine.begin();
+    auto b = theirs.begin();
+    while (a != mine.end() || b != theirs.end()) {
+      if (b == theirs.end() || (a != mine.end() && m_compare((*a)->key, (*b)->key))) {
+        kept.append(*a++);
+      } else if (a == mine.end() || m_compare((*b)->key, (*a)->key)) {
+        kept.append(*b++);
+      } else {
+        kept.append(*a++);
+        rejected.append(*b++);
+      }
+    }
+
+    m_adopt(kept);
+    other.m_adopt(rejected);
+  }
+
+  /**
+   * @brief Insert a key-value pair into the skiplist
+   *
+   * @param key The key
+   * @param value The value
+   * @return true If inserted successfully
+   * @return false If not inserted (e.g., duplicate key)
+   */
+  bool insert(Key const &key, T const &value) {
+    return m_try_emplace(key, value).second;
+  }
+
+  /**
+   * @brief Insert a key-value pair into the skiplist, moving from both
+   *
+   * @param key The key
+   * @param value The value
+   * @return true If inserted successfully
+   * @return false If not inserted (e.g., duplicate key); nothing is moved from
+   */
+  bool insert(Key &&key, T &&value) {
+    return m_try_emplace(std::move(key), std::move(value)).second;
+  }
+
+  /**
+   * @brief Construct a key and value in place if the key is not present
+   *
+   * @param key Argument the key is constructed from
+   * @param args Arguments the value is constructed from
+   * @return std::pair<iterator, bool> The element for the key and whether it was
+   * inserted
+   */
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace(K &&key, Args &&...args) {
+    Key k(std::forward<K>(key));
+    auto [node, inserted] = m_try_emplace(std::move(k), std::forward<Args>(args)...);
+    return {iterator(node), inserted};
+  }
+
+  /**
+   * @brief Construct the value in place if the key is not present. Neither the key
+   * nor `args` are moved from when the key already exists.
+   *
+   * @param key The key
+   * @param args Arguments the value is constructed from
+   * @return std::pair<iterator, bool> The element for the key and whether it was
+   * inserted
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key const &key, Args &&...args) {
+    auto [node, inserted] = m_try_emplace(key, std::forward<Args>(args)...);
+    return {iterator(node), inserted};
+  }
+
+  /**
+   * @brief Construct the value in place if the key is not present, moving the key
+   * into the new element
+   *
+   * @param key The key
+   * @param args Arguments the value is constructed from
+   * @return std::pair<iterator, bool> The element for the key and whether it was
+   * inserted
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    auto [node, inserted] = m_try_emplace(std::move(key), std::forward<Args>(args)...);
+    return {iterator(node), inserted};
+  }
+
+  /**
+   * @brief Insert a new element or assign to the value of the existing one
+   *
+   * @param key The key
+   * @param obj The value to insert or assign
+   * @return std::pair<iterator, bool> The element for the key and whether it was
+   * inserted (false means assigned)
+   */
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key const &key, M &&obj) {
+    auto [node, inserted] = m_try_emplace(key, std::forward<M>(obj));
+    if (!inserted) {
+      node->value = std::forward<M>(obj);
+    }
+    return {iterator(node), inserted};
+  }
+
+  /**
+   * @brief Insert a new element or assign to the value of the existing one, moving
+   * the key into the new element
+   *
+   * @param key The key
+   * @param obj The value to insert or assign
+   * @return std::pair<iterator, bool> The element for the key and whether it was
+   * inserted (false means assigned)
+   */
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&obj) {
+    auto [node, inserted] = m_try_emplace(std::move(key), std::forward<M>(obj));
+    if (!inserted) {
+      node->value = std::forward<M>(obj);
+    }
+    return {iterator(node), inserted};
   }
 
   /**
@@ -168,21 +891,11 @@ public:
    * @return false If key was not found
    */
   [[nodiscard]] bool search(Key const &key, T &value) const {
-    Node *current = m_head.get();
-
-    // Search from the highest level downwards
-    for (int i = m_level - 1; i >= 0; --i) {
-      current = m_descend(current, i, key);
-    }
-
-    current = (!current->forward.empty()) ? current->forward[0].get() : nullptr;
-
-    // Check if we found the key
-    if (current && !m_compare(current->key, key) && !m_compare(key, current->key)) {
+    Node *current = m_find(key);
+    if (current) {
       value = current->value;
       return true;
     }
-
     return false;
   }
 
@@ -193,9 +906,22 @@ public:
    * @return true If key exists
    * @return false If key does not exist
    */
-  [[nodiscard]] bool contains(Key const &key) const {
-    T dummy;
-    return search(key, dummy);
+  [[nodiscard]] bool contains(Key const &key) const noexcept {
+    return m_find(key) != nullptr;
+  }
+
+  /**
+   * @brief Check if a key equivalent to `key` exists, without constructing a Key
+   * (only available with a transparent comparator)
+   *
+   * @param key A value comparable with Key
+   * @return true If an equivalent key exists
+   * @return false If no equivalent key exists
+   */
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  [[nodiscard]] bool contains(K const &key) const noexcept {
+    return m_find(key) != nullptr;
   }
 
   /**
@@ -206,33 +932,21 @@ public:
    * @return false If key was not found
    */
   bool erase(Key const &key) {
-    std::vector<Node *> update(MAX_LEVEL);
-    Node *current = m_head.get();
+    Node *update[MAX_LEVEL];
+    Probe<Key> const probe(key);
+    Node *current = m_head;
 
     // Find the node to remove at each level
     for (int i = m_level - 1; i >= 0; --i) {
-      current = m_descend(current, i, key);
+      current = m_descend(current, i, probe);
       update[i] = current;
     }
 
-    current = (!current->forward.empty()) ? current->forward[0].get() : nullptr;
+    current = current->forward()[0].node;
 
     // If key was found, remove it
-    if (current && !m_compare(current->key, key) && !m_compare(key, current->key)) {
-      // Update pointers at each level
-      for (int i = 0; i < m_level; i++) {
-        if (update[i]->forward[i].get() != current) {
-          break;
-        }
-        update[i]->forward[i] = current->forward[i];
-      }
-
-      // Update the level if needed
-      while (m_level > 1 && !m_head->forward[m_level - 1]) {
-        m_level--;
-      }
-
-      m_size--;
+    if (current && !m_compare(key, current->key)) {
+      m_unlink(current, update);
       return true;
     }
 
@@ -254,11 +968,19 @@ public:
    */
   [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
 
+  /**
+   * @brief Get the height of the tallest tower currently in the list
+   *
+   * @return int The number of levels a search descends through
+   */
+  [[nodiscard]] int level() const noexcept { return m_level; }
+
   /**
    * @brief Iterator for traversing the skiplist
    */
   class iterator {
   private:
+    friend class SkipList;
     Node *current;
 
   public:
@@ -267,11 +989,12 @@ public:
     using pointer = void;
     using difference_type = std::ptrdiff_t;
     using iterator_category = std::forward_iterator_tag;
+    iterator() noexcept : current(nullptr) {}
     iterator(Node *node) noexcept : current(node) {}
 
     iterator &operator++() noexcept {
       if (current) {
-        current = current->forward[0].get();
+        current = current->forward()[0].node;
       }
       return *this;
     }
@@ -296,7 +1019,7 @@ public:
    *
    * @return iterator
    */
-  iterator begin() noexcept { return iterator(m_head->forward[0].get()); }
+  iterator begin() noexcept { return iterator(m_head->forward()[0].node); }
 
   /**
    * @brief Get an iterator to the end
@@ -311,20 +1034,188 @@ public:
    * @param key The key to find
    * @return iterator Iterator pointing to the found key or end() if not found
    */
-  [[nodiscard]] iterator find(Key const &key) {
-    Node *current = m_head.get();
+  [[nodiscard]] iterator find(Key const &key) { return iterator(m_find(key)); }
+
+  /**
+   * @brief Find a key equivalent to `key` without constructing a Key (only
+   * available with a transparent comparator, e.g. std::less<>)
+   *
+   * @param key A value comparable with Key
+   * @return iterator Iterator pointing to the found key or end() if not found
+   */
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  [[nodiscard]] iterator find(K const &key) {
+    return iterator(m_find(key));
+  }
+
+  /**
+   * @brief Find the first element whose key is not less than `key`
+   *
+   * @param key The key to compare against
+   * @return iterator Iterator to the first such element or end() if none
+   */
+  [[nodiscard]] iterator lower_bound(Key const &key) {
+    return iterator(m_lower_bound(key));
+  }
+
+  /**
+   * @brief Find the first element whose key is greater than `key`
+   *
+   * @param key The key to compare against
+   * @return iterator Iterator to the first such element or end() if none
+   */
+  [[nodiscard]] iterator upper_bound(Key const &key) {
+    return iterator(m_upper_bound(key));
+  }
+
+  /**
+   * @brief Get the range of elements equivalent to `key`. Keys are unique, so the
+   * range holds at most one element and the upper end is found along level 0.
+   *
+   * @param key The key to compare against
+   * @return std::pair<iterator, iterator> The [lower_bound, upper_bound) pair
+   */
+  [[nodiscard]] std::pair<iterator, iterator> equal_range(Key const &key) {
+    Node *first = m_lower_bound(key);
+    Node *last = first;
+    if (last && !m_compare(key, last->key)) {
+      last = last->forward()[0].node;
+    }
+    return {iterator(first), iterator(last)};
+  }
+
+  /**
+   * @brief Get the element with the given 0-based rank in O(log n)
+   *
+   * @param rank The number of elements ordered before the requested one
+   * @return iterator Iterator to the element or end() if rank >= size()
+   */
+  [[nodiscard]] iterator at_rank(std::size_t rank) {
+    if (rank >= m_size) {
+      return end();
+    }
+
+    std::size_t const target = rank + 1;
+    std::size_t pos = 0;
+    Node *current = m_head;
+    for (int i = m_level - 1; i >= 0; --i) {
+      for (Link const *link = current->forward() + i;
+           link->node && pos + link->width <= target; link = current->forward() + i) {
+        pos += link->width;
+        current = link->node;
+      }
+      if (pos == target) {
+        break;
+      }
+    }
+    return iterator(current);
+  }
 
+  /**
+   * @brief Count the elements whose keys are ordered before `key` in O(log n). The
+   * key does not need to be present.
+   *
+   * @param key The key to compare against
+   * @return size_t The number of keys less than `key`
+   */
+  [[nodiscard]] size_t rank_of(Key const &key) const noexcept {
+    Probe<Key> const probe(key);
+    std::size_t pos = 0;
+    Node *current = m_head;
     for (int i = m_level - 1; i >= 0; --i) {
-      current = m_descend(current, i, key);
+      current = m_descend(current, i, probe, pos);
     }
+    return pos;
+  }
 
-    current = (!current->forward.empty()) ? current->forward[0].get() : nullptr;
+  /**
+   * @brief Remove the element with the given 0-based rank in O(log n)
+   *
+   * @param rank The number of elements ordered before the one to remove
+   * @return true If an element was removed
+   * @return false If rank >= size()
+   */
+  bool erase_at(std::size_t rank) {
+    if (rank >= m_size) {
+      return false;
+    }
 
-    if (current && !m_compare(current->key, key) && !m_compare(key, current->key)) {
-      return iterator(current);
+    Node *update[MAX_LEVEL];
+    std::size_t const target = rank + 1;
+    std::size_t pos = 0;
+    Node *current = m_head;
+    for (int i = m_level - 1; i >= 0; --i) {
+      for (Link const *link = current->forward() + i;
+           link->node && pos + link->width < target; link = current->forward() + i) {
+        pos += link->width;
+        current = link->node;
+      }
+      update[i] = current;
     }
 
-    return end();
+    m_unlink(current->forward()[0].node, update);
+    return true;
+  }
+
+  /**
+   * @brief A lightweight view over the elements with keys in [lo, hi). The start is
+   * located with a single descent; iteration then streams along level 0 and stops
+   * at the first key not less than `hi`, so no second seek is needed.
+   */
+  class range_view {
+  private:
+    iterator m_first;
+    Key m_hi;
+    Compare const *m_compare;
+
+  public:
+    /**
+     * @brief Sentinel marking the end of the view
+     */
+    class sentinel {
+    private:
+      friend class range_view;
+      Key const *m_hi = nullptr;
+      Compare const *m_compare = nullptr;
+
+      sentinel(Key const *hi, Compare const *comp) noexcept
+          : m_hi(hi), m_compare(comp) {}
+
+      bool reached(iterator const &it) const noexcept {
+        return !it.current || (m_hi && !(*m_compare)(it.current->key, *m_hi));
+      }
+
+    public:
+      /**
+       * @brief A default-constructed sentinel is only reached at the end of the list
+       */
+      sentinel() = default;
+
+      friend bool operator==(iterator const &it, sentinel const &s) noexcept {
+        return s.reached(it);
+      }
+    };
+
+    range_view(iterator first, Key hi, Compare const *comp)
+        : m_first(first), m_hi(std::move(hi)), m_compare(comp) {}
+
+    [[nodiscard]] iterator begin() const noexcept { return m_first; }
+
+    [[nodiscard]] sentinel end() const noexcept { return sentinel(&m_hi, m_compare); }
+
+    [[nodiscard]] bool empty() const noexcept { return begin() == end(); }
+  };
+
+  /**
+   * @brief Get a view over all elements with keys in [lo, hi), in O(log n + k)
+   *
+   * @param lo The inclusive lower bound
+   * @param hi The exclusive upper bound
+   * @return range_view A view that streams the elements in order
+   */
+  [[nodiscard]] range_view range(Key const &lo, Key const &hi) {
+    return range_view(iterator(m_lower_bound(lo)), hi, &m_compare);
   }
 };
 
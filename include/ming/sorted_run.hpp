@@ -0,0 +1,572 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_SORTED_RUN
+#define MING_SORTED_RUN
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <ming/mapped_file.hpp>
+
+namespace ming {
+
+/**
+ * @brief Serialization of keys and values in a sorted run. Specialize it to store
+ * other types: `encode` appends the bytes of a value, `decode` reads one back and
+ * advances the cursor, and `skip` advances past one without materializing it.
+ * Readers throw std::runtime_error instead of reading past `end`.
+ *
+ * @tparam T The type to serialize
+ */
+template <typename T>
+struct RunCodec;
+
+/**
+ * @brief Trivially copyable types are stored as their raw bytes, in host order
+ */
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+struct RunCodec<T> {
+  static void encode(std::string &out, T const &value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+  }
+
+  static T decode(char const *&p, char const *end) {
+    check(p, end, sizeof(T));
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+  }
+
+  static void skip(char const *&p, char const *end) {
+    check(p, end, sizeof(T));
+    p += sizeof(T);
+  }
+
+  static void check(char const *p, char const *end, std::size_t n) {
+    if (static_cast<std::size_t>(end - p) < n) {
+      throw std::runtime_error("Corrupt sorted run!");
+    }
+  }
+};
+
+/**
+ * @brief Strings are stored as a 32-bit length followed by their bytes
+ */
+template <>
+struct RunCodec<std::string> {
+  using length_codec = RunCodec<std::uint32_t>;
+
+  static void encode(std::string &out, std::string const &value) {
+    if (value.size() > UINT32_MAX) {
+      throw std::length_error("String is too long for a sorted run!");
+    }
+    length_codec::encode(out, static_cast<std::uint32_t>(value.size()));
+    out.append(value);
+  }
+
+  static std::string decode(char const *&p, char const *end) {
+    std::uint32_t const n = length_codec::decode(p, end);
+    length_codec::check(p, end, n);
+    std::string value(p, n);
+    p += n;
+    return value;
+  }
+
+  static void skip(char const *&p, char const *end) {
+    std::uint32_t const n = length_codec::decode(p, end);
+    length_codec::check(p, end, n);
+    p += n;
+  }
+};
+
+/**
+ * @brief Layout knobs for writing a sorted run
+ */
+struct SortedRunOptions {
+  // Entries are grouped into blocks of about this many bytes, one index entry each
+  std::size_t block_size = 4096;
+  // Bloom filter budget; about 1% false positives at 10, 0 disables the filter
+  std::size_t bloom_bits_per_key = 10;
+};
+
+/**
+ * @brief An immutable, memory-mapped file of key-value pairs in key order, for
+ * spilling a frozen in-memory table (e.g. a SkipList) to disk.
+ *
+ * The file holds the entries back to back, cut into blocks of about
+ * `block_size` bytes. A sparse index stores the first key of each block, and an
+ * optional bloom filter lets most lookups of absent keys skip the data entirely.
+ * The index is decoded on open. A lookup binary searches it and then scans a
+ * single block of the mapping; a range scan streams through the mapping in order.
+ *
+ *   [block 0 | block 1 | ...][index: (first key, offset) ...][bloom bits][footer]
+ *
+ * Fixed-width fields are in host byte order. The bloom filter hashes encoded keys,
+ * so keys that compare equal must encode to the same bytes.
+ *
+ * @see https://www.cs.umb.edu/~poneil/lsmtree.pdf
+ *
+ * @tparam Key The key type, serialized with RunCodec<Key>
+ * @tparam T The value type, serialized with RunCodec<T>
+ * @tparam Compare The comparison function the run is sorted by
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class SortedRun {
+private:
+  static constexpr std::uint64_t MAGIC = 0x314e5552474e494dULL; // "MINGRUN1"
+
+  struct Footer {
+    std::uint64_t magic;
+    std::uint64_t entries;
+    std::uint64_t data_end;
+    std::uint64_t index_offset;
+    std::uint64_t index_count;
+    std::uint64_t bloom_offset;
+    std::uint64_t bloom_bits;
+    std::uint64_t bloom_hashes;
+  };
+
+  using key_codec = RunCodec<Key>;
+  using value_codec = RunCodec<T>;
+  using offset_codec = RunCodec<std::uint64_t>;
+
+  MappedFile m_file;
+  char const *m_data;
+  std::size_t m_size;
+  Footer m_footer;
+  // First key and file offset of every block
+  std::vector<std::pair<Key, std::uint64_t>> m_index;
+  Compare m_compare;
+
+  static std::uint64_t m_hash(std::string_view bytes) noexcept {
+    // FNV-1a, finished with the splitmix64 mixer to spread the low bits
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : bytes) {
+      h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+    }
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+  }
+
+  // Double hashing: probe i is h1 + i * h2
+  template <typename F>
+  static void m_bloom_probes(std::uint64_t h, std::uint64_t bits, std::uint64_t hashes,
+                             F &&f) {
+    std::uint64_t const step = (h >> 32) | (h << 32) | 1;
+    for (std::uint64_t i = 0; i < hashes; ++i) {
+      f((h + i * step) % bits);
+    }
+  }
+
+  /**
+   * @brief Removes a partially written file when write() exits by an exception
+   */
+  struct TempFile {
+    std::filesystem::path path;
+    bool keep = false;
+
+    ~TempFile() {
+      if (!keep) {
+        std::error_code ignored;
+        std::filesystem::remove(path, ignored);
+      }
+    }
+  };
+
+  char const *m_data_end() const noexcept { return m_data + m_footer.data_end; }
+
+  /**
+   * @brief Position of the first entry whose key is not less than `key`, found by
+   * scanning forward from the block that may hold it
+   */
+  char const *m_seek(Key const &key) const {
+    auto block = std::ranges::upper_bound(m_index, key, m_compare,
+                                          &std::pair<Key, std::uint64_t>::first);
+    if (block != m_index.begin()) {
+      --block;
+    }
+    char const *p = block == m_index.end() ? m_data_end() : m_data + block->second;
+    char const *const end = m_data_end();
+    while (p != end) {
+      char const *entry = p;
+      Key const k = key_codec::decode(p, end);
+      if (!m_compare(k, key)) {
+        return entry;
+      }
+      value_codec::skip(p, end);
+    }
+    return end;
+  }
+
+  void m_load() {
+    if (m_size < sizeof(Footer)) {
+      throw std::runtime_error("Corrupt sorted run!");
+    }
+    std::memcpy(&m_footer, m_data + m_size - sizeof(Footer), sizeof(Footer));
+    std::uint64_t const body = m_size - sizeof(Footer);
+    if (m_footer.magic != MAGIC || m_footer.data_end > m_footer.index_offset ||
+        m_footer.index_offset > m_footer.bloom_offset || m_footer.bloom_offset > body ||
+        m_footer.bloom_bits / 8 + (m_footer.bloom_bits % 8 != 0) >
+            body - m_footer.bloom_offset ||
+        // Every index entry holds at least its 8-byte block offset
+        m_footer.index_count >
+            (m_footer.bloom_offset - m_footer.index_offset) / sizeof(std::uint64_t)) {
+      throw std::runtime_error("Corrupt sorted run!");
+    }
+
+    char const *p = m_data + m_footer.index_offset;
+    char const *const end = m_data + m_footer.bloom_offset;
+    m_index.reserve(m_footer.index_count);
+    for (std::uint64_t i = 0; i < m_footer.index_count; ++i) {
+      Key key = key_codec::decode(p, end);
+      std::uint64_t const offset = offset_codec::decode(p, end);
+      if (offset >= m_footer.data_end) {
+        throw std::runtime_error("Corrupt sorted run!");
+      }
+      m_index.emplace_back(std::move(key), offset);
+    }
+  }
+
+public:
+  /**
+   * @brief Forward iterator over the entries of a run. Entries are decoded one at
+   * a time as the iterator advances.
+   */
+  class iterator {
+  private:
+    friend class SortedRun;
+
+    char const *m_pos;
+    char const *m_next;
+    char const *m_end;
+    std::optional<std::pair<Key, T>> m_current;
+
+    iterator(char const *pos, char const *end) : m_pos(pos), m_next(pos), m_end(end) {
+      load();
+    }
+
+    void load() {
+      if (m_pos == m_end) {
+        m_current.reset();
+        return;
+      }
+      char const *p = m_pos;
+      Key key = key_codec::decode(p, m_end);
+      T value = value_codec::decode(p, m_end);
+      m_next = p;
+      m_current.emplace(std::move(key), std::move(value));
+    }
+
+  public:
+    using value_type = std::pair<Key, T>;
+    using reference = value_type const &;
+    using pointer = value_type const *;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    iterator() noexcept : m_pos(nullptr), m_next(nullptr), m_end(nullptr) {}
+
+    iterator &operator++() {
+      m_pos = m_next;
+      load();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(iterator const &other) const noexcept {
+      return m_pos == other.m_pos;
+    }
+
+    bool operator!=(iterator const &other) const noexcept { return !(*this == other); }
+
+    reference operator*() const noexcept { return *m_current; }
+
+    pointer operator->() const noexcept { return &*m_current; }
+  };
+
+  /**
+   * @brief A view over the entries with keys in [lo, hi)
+   */
+  class range_view {
+  private:
+    iterator m_first;
+    Key m_hi;
+    Compare const *m_compare;
+
+  public:
+    /**
+     * @brief Sentinel marking the end of the view
+     */
+    class sentinel {
+    private:
+      friend class range_view;
+      Key const *m_hi;
+      Compare const *m_compare;
+
+      sentinel(Key const *hi, Compare const *comp) noexcept
+          : m_hi(hi), m_compare(comp) {}
+
+      bool reached(iterator const &it) const {
+        return !it.m_current || !(*m_compare)(it.m_current->first, *m_hi);
+      }
+
+    public:
+      friend bool operator==(iterator const &it, sentinel const &s) {
+        return s.reached(it);
+      }
+    };
+
+    range_view(iterator first, Key hi, Compare const *comp)
+        : m_first(std::move(first)), m_hi(std::move(hi)), m_compare(comp) {}
+
+    [[nodiscard]] iterator begin() const { return m_first; }
+
+    [[nodiscard]] sentinel end() const noexcept { return sentinel(&m_hi, m_compare); }
+
+    [[nodiscard]] bool empty() const { return begin() == end(); }
+  };
+
+  /**
+   * @brief Stream key-value pairs sorted by `comp` into a new run file, then open
+   * it. The file is written under a temporary name and renamed into place, so a
+   * run at `path` is always complete; the temporary file is removed on failure.
+   *
+   * @param path Where to create the run
+   * @param sorted Pairs in strictly ascending key order, e.g. a frozen SkipList
+   * @param options Block size and bloom filter budget
+   * @param comp The comparison function object
+   * @return SortedRun The newly written run
+   * @throws std::invalid_argument If the input is not strictly sorted
+   * @throws std::runtime_error If the file cannot be written
+   */
+  template <std::ranges::input_range R>
+  static SortedRun write(std::filesystem::path const &path, R &&sorted,
+                         SortedRunOptions const &options = {},
+                         Compare comp = Compare{}) {
+    std::filesystem::path const tmp = path.string() + ".tmp";
+    // Declared before `out` so the stream is closed by the time it runs
+    TempFile guard{tmp};
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("Failed to create sorted run!");
+    }
+
+    std::string block;
+    std::string index;
+    std::vector<std::uint64_t> hashes;
+    std::optional<Key> prev;
+    std::uint64_t offset = 0;
+    std::uint64_t entries = 0;
+    std::uint64_t blocks = 0;
+
+    auto flush = [&] {
+      out.write(block.data(), static_cast<std::streamsize>(block.size()));
+      offset += block.size();
+      block.clear();
+    };
+
+    for (auto &&[key, value] : sorted) {
+      if (prev && !comp(*prev, key)) {
+        throw std::invalid_argument("SortedRun input is not sorted!");
+      }
+      if (block.empty()) {
+        key_codec::encode(index, key);
+        offset_codec::encode(index, offset);
+        ++blocks;
+      }
+
+      std::size_t const start = block.size();
+      key_codec::encode(block, key);
+      if (options.bloom_bits_per_key) {
+        hashes.push_back(m_hash(std::string_view(block).substr(start)));
+      }
+      value_codec::encode(block, value);
+      prev = key;
+      ++entries;
+
+      if (block.size() >= options.block_size) {
+        flush();
+      }
+    }
+    flush();
+
+    Footer footer{MAGIC, entries, offset, offset, blocks, offset + index.size(), 0, 0};
+    out.write(index.data(), static_cast<std::streamsize>(index.size()));
+
+    if (!hashes.empty()) {
+      footer.bloom_bits =
+          std::max<std::uint64_t>(64, entries * options.bloom_bits_per_key);
+      // k = bits per key * ln 2 minimises the false positive rate
+      footer.bloom_hashes =
+          std::clamp<std::uint64_t>(options.bloom_bits_per_key * 69 / 100, 1, 30);
+      std::vector<unsigned char> bloom((footer.bloom_bits + 7) / 8);
+      for (std::uint64_t h : hashes) {
+        m_bloom_probes(h, footer.bloom_bits, footer.bloom_hashes,
+                       [&](std::uint64_t bit) {
+                         bloom[bit / 8] |= static_cast<unsigned char>(1u << (bit % 8));
+                       });
+      }
+      out.write(reinterpret_cast<char const *>(bloom.data()),
+                static_cast<std::streamsize>(bloom.size()));
+    }
+
+    out.write(reinterpret_cast<char const *>(&footer), sizeof(Footer));
+    out.close();
+    if (!out) {
+      throw std::runtime_error("Failed to write sorted run!");
+    }
+    std::filesystem::rename(tmp, path);
+    guard.keep = true;
+    return SortedRun(path, std::move(comp));
+  }
+
+  /**
+   * @brief Open and map an existing run
+   *
+   * @param path The run file
+   * @param comp The comparison function the run was written with
+   * @throws std::runtime_error If the file cannot be mapped or is malformed
+   */
+  explicit SortedRun(std::filesystem::path const &path, Compare comp = Compare{})
+      : m_file(path), m_data(m_file.data()), m_size(m_file.size()), m_footer{},
+        m_compare(std::move(comp)) {
+    m_load();
+  }
+
+  SortedRun(SortedRun const &) = delete;
+  SortedRun &operator=(SortedRun const &) = delete;
+  SortedRun(SortedRun &&) noexcept = default;
+  SortedRun &operator=(SortedRun &&) noexcept = default;
+
+  /**
+   * @brief Check the bloom filter for `key`
+   *
+   * @param key The key to test
+   * @return false If the key is definitely absent
+   * @return true If the key may be present (always, without a filter)
+   */
+  [[nodiscard]] bool may_contain(Key const &key) const {
+    if (m_footer.bloom_bits == 0) {
+      return true;
+    }
+    std::string encoded;
+    key_codec::encode(encoded, key);
+    auto const *bloom =
+        reinterpret_cast<unsigned char const *>(m_data + m_footer.bloom_offset);
+    bool present = true;
+    m_bloom_probes(m_hash(encoded), m_footer.bloom_bits, m_footer.bloom_hashes,
+                   [&](std::uint64_t bit) {
+                     present = present && (bloom[bit / 8] >> (bit % 8) & 1u);
+                   });
+    return present;
+  }
+
+  /**
+   * @brief Look up the value of `key`
+   *
+   * @param key The key to search for
+   * @return std::optional<T> The value, or std::nullopt if the key is absent
+   */
+  [[nodiscard]] std::optional<T> find(Key const &key) const {
+    if (!may_contain(key)) {
+      return std::nullopt;
+    }
+    char const *p = m_seek(key);
+    char const *const end = m_data_end();
+    if (p == end) {
+      return std::nullopt;
+    }
+    if (m_compare(key, key_codec::decode(p, end))) {
+      return std::nullopt;
+    }
+    return value_codec::decode(p, end);
+  }
+
+  /**
+   * @brief Check if `key` is in the run
+   */
+  [[nodiscard]] bool contains(Key const &key) const { return find(key).has_value(); }
+
+  /**
+   * @brief Get the number of entries in the run
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return m_footer.entries; }
+
+  /**
+   * @brief Check if the run is empty
+   */
+  [[nodiscard]] bool empty() const noexcept { return m_footer.entries == 0; }
+
+  /**
+   * @brief Get an iterator to the first entry
+   */
+  [[nodiscard]] iterator begin() const { return iterator(m_data, m_data_end()); }
+
+  /**
+   * @brief Get an iterator to the end
+   */
+  [[nodiscard]] iterator end() const { return iterator(m_data_end(), m_data_end()); }
+
+  /**
+   * @brief Get an iterator to the first entry whose key is not less than `key`
+   */
+  [[nodiscard]] iterator lower_bound(Key const &key) const {
+    return iterator(m_seek(key), m_data_end());
+  }
+
+  /**
+   * @brief Get a view over all entries with keys in [lo, hi)
+   *
+   * @param lo The inclusive lower bound
+   * @param hi The exclusive upper bound
+   * @return range_view A view that streams the entries in order
+   */
+  [[nodiscard]] range_view range(Key const &lo, Key const &hi) const {
+    return range_view(lower_bound(lo), hi, &m_compare);
+  }
+};
+
+} // namespace ming
+
+#endif // MING_SORTED_RUN
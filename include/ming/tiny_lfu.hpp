@@ -0,0 +1,193 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_TINY_LFU
+#define MING_TINY_LFU
+
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <ming/frequency_sketch.hpp>
+#include <ming/weighted_lru.hpp>
+
+namespace ming {
+
+/**
+ * @brief A weighted cache with W-TinyLFU admission: new entries must prove
+ * themselves more popular than what they would displace
+ *
+ * New entries enter a small window LRU holding 1% of the weight budget, which
+ * absorbs bursts of recent keys. Whatever the window evicts becomes a candidate
+ * for the main cache, a segmented LRU. If the main cache is full, the candidate's
+ * estimated frequency, taken from a FrequencySketch of every get() and put(), is
+ * compared with that of the main cache's next victim: the candidate is only
+ * admitted, evicting that victim, if it has been seen strictly more often, and is
+ * otherwise dropped. A long scan of one-off keys therefore passes through the
+ * window without flushing the frequently used entries in the main cache.
+ *
+ * @see https://arxiv.org/abs/1512.00727
+ *
+ * @tparam K The key type; hashed with std::hash<K>
+ * @tparam V The value type
+ */
+template <typename K, typename V>
+class TinyLFU {
+  using Cache = WeightedLRU<K, V>;
+  using MainCache = WeightedLRU<K, V, SLRUPolicy>;
+
+  /** @brief The share of the weight budget given to the window, in percent */
+  static constexpr int WINDOW_PERCENT = 1;
+
+  Cache m_window;
+  MainCache m_main;
+  FrequencySketch<K> m_sketch;
+
+  /**
+   * @brief The window's share of `capacity`: at least 1 while that leaves the main
+   * cache room for an entry of weight 1, so a cache of capacity 1 has no window
+   *
+   * @throws std::invalid_argument If `capacity` is not positive
+   */
+  static int m_window_capacity(int capacity) {
+    if (capacity < 1) {
+      throw std::invalid_argument("TinyLFU capacity must be positive!");
+    }
+    return std::min(std::max(capacity / 100 * WINDOW_PERCENT, 1), capacity - 1);
+  }
+
+  /**
+   * @brief Offer an entry leaving the window to the main cache
+   */
+  void m_admit(K key, V value, int size) {
+    unsigned const frequency = m_sketch.frequency(key);
+    while (m_main.weight() + size > m_main.capacity()) {
+      auto const victim = m_main.victim();
+      if (frequency <= m_sketch.frequency(m_main.item(victim).key)) {
+        return;
+      }
+      m_main.extract(victim);
+    }
+    m_main.put(std::move(key), std::move(value), size);
+  }
+
+public:
+  /**
+   * @brief Construct an empty cache, expecting entries of weight about 1
+   *
+   * @param capacity The largest total weight the cache may hold
+   * @throws std::invalid_argument If `capacity` is not positive
+   */
+  explicit TinyLFU(int capacity)
+      : TinyLFU(capacity, static_cast<std::size_t>(std::max(capacity, 1))) {}
+
+  /**
+   * @brief Construct an empty cache
+   *
+   * @param capacity The largest total weight the cache may hold
+   * @param expected_entries About how many entries fit, to size the sketch
+   * @throws std::invalid_argument If `capacity` is not positive
+   */
+  TinyLFU(int capacity, std::size_t expected_entries)
+      : m_window(m_window_capacity(capacity)),
+        m_main(capacity - m_window.capacity()), m_sketch(expected_entries) {}
+
+  /**
+   * @brief Look up a key, counting the access
+   *
+   * @param key The key to look up
+   * @return std::expected<V, std::string> A copy of the value, or an error if the
+   * key is not cached
+   */
+  std::expected<V, std::string> get(K const &key) {
+    m_sketch.increment(key);
+    if (auto const e = m_window.find(key); e != Cache::NOT_CACHED) {
+      m_window.touch(e);
+      return m_window.value(e);
+    }
+    return m_main.get(key);
+  }
+
+  /**
+   * @brief Insert or update an entry, counting the access. An update stays where
+   * the entry is; a new entry goes through the window, or straight to admission if
+   * it is heavier than the window.
+   *
+   * @param key The key
+   * @param value The value
+   * @param size The entry's weight
+   * @throws std::runtime_error If `size` exceeds the main cache's capacity
+   */
+  void put(K key, V value, int size) {
+    if (size > m_main.capacity()) {
+      throw std::runtime_error("Sorry this is too big!");
+    }
+    m_sketch.increment(key);
+    if (m_main.find(key) != MainCache::NOT_CACHED) {
+      m_main.put(std::move(key), std::move(value), size);
+      return;
+    }
+    if (auto const e = m_window.find(key); e != Cache::NOT_CACHED) {
+      m_window.extract(e);
+    }
+    if (size > m_window.capacity()) {
+      m_admit(std::move(key), std::move(value), size);
+      return;
+    }
+    while (m_window.weight() + size > m_window.capacity()) {
+      auto candidate = m_window.extract(m_window.victim());
+      m_admit(std::move(candidate.key), std::move(candidate.value), candidate.size);
+    }
+    m_window.put(std::move(key), std::move(value), size);
+  }
+
+  /**
+   * @brief Get the number of cached entries
+   */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return m_window.size() + m_main.size();
+  }
+
+  /**
+   * @brief Get the total weight of the cached entries
+   */
+  [[nodiscard]] int weight() const noexcept {
+    return m_window.weight() + m_main.weight();
+  }
+
+  /**
+   * @brief Get the largest total weight the cache may hold
+   */
+  [[nodiscard]] int capacity() const noexcept {
+    return m_window.capacity() + m_main.capacity();
+  }
+
+  /**
+   * @brief Get the number of bytes reserved for entries, indices and the sketch
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_window.memory_usage() + m_main.memory_usage() + m_sketch.memory_usage();
+  }
+};
+
+} // namespace ming
+
+#endif // MING_TINY_LFU
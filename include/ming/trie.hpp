@@ -19,143 +19,413 @@
 #ifndef MING_TRIE
 #define MING_TRIE
 
-#include <memory>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <queue>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <string_view>
-#include <unordered_map>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include <ming/aho_corasick.hpp>
+#include <ming/louds_trie.hpp>
+#include <ming/trie_node_pool.hpp>
 
 namespace ming {
 
+/**
+ * @brief How a Trie splits the characters of a key into edge labels
+ */
+enum class TrieSplit {
+  // One level per byte, up to 256 children per node
+  byte,
+  // Two levels per byte, high nibble first, at most 16 children per node
+  nibble,
+};
+
+template <class T>
+concept TrieKey = std::integral<T> && (!std::same_as<T, bool>);
+
+/**
+ * @brief A range of characters that is not already a string view, e.g. a
+ * std::vector<char32_t> or a transformed view
+ */
+template <class R, class Key>
+concept TrieKeyRange =
+    std::ranges::input_range<R> && std::same_as<std::ranges::range_value_t<R>, Key> &&
+    (!std::convertible_to<R, std::basic_string_view<Key>>);
+
 /**
  * @brief A trie data structure for storing and retrieving strings
  *
+ * Nodes are kept in a TrieNodePool and addressed by 32-bit indices, with a
+ * child representation that adapts to each node's fan-out. Copying is a copy of
+ * a few flat arrays and destruction never recurses, however long the keys are.
+ *
+ * Edges are labelled with bytes. A wider character is split into its bytes, most
+ * significant first, so that byte order is the order of the characters and
+ * Trie<char16_t> or Trie<char32_t> can store native strings. With
+ * TrieSplit::nibble every byte is split again into two 16-way levels, so no node
+ * ever needs more than a 16-entry sorted array. Paths get twice as deep, though,
+ * and since nodes already adapt to their fan-out, the byte split is usually both
+ * smaller and faster; measure before choosing the nibble split.
+ *
  * @tparam Key The character type used for storing keys (defaults to char)
+ * @tparam Split How characters are split into edge labels
  */
-template <typename Key = char>
+template <TrieKey Key = char, TrieSplit Split = TrieSplit::byte>
 class Trie {
+  using index_type = TrieNodePool::index_type;
+  using unit_type = std::make_unsigned_t<Key>;
+
+  static constexpr unsigned LABEL_BITS = Split == TrieSplit::byte ? 8 : 4;
+  /** @brief How many edges one character of a key takes */
+  static constexpr std::size_t LABELS_PER_CHAR = sizeof(Key) * 8 / LABEL_BITS;
+  /** @brief Whether the labels along a path are exactly the characters of a word */
+  static constexpr bool PLAIN = std::same_as<Key, char> && Split == TrieSplit::byte;
+
   /**
-   * @brief Node class for the trie structure
+   * @brief The `j`-th label of character `c`, most significant first
    */
-  class TrieNode {
-  public:
-    TrieNode() : end_of_word(false){};
+  static std::uint8_t m_label(Key c, std::size_t j) noexcept {
+    auto const shift = (LABELS_PER_CHAR - 1 - j) * LABEL_BITS;
+    return static_cast<std::uint8_t>((static_cast<unit_type>(c) >> shift) &
+                                     ((1u << LABEL_BITS) - 1));
+  }
 
-    bool end_of_word;
-    std::unordered_map<Key, std::unique_ptr<TrieNode>> children;
-  };
+  /**
+   * @brief The labels spelling `word`, as bytes
+   */
+  template <typename R>
+  static std::string m_encode(R &&word) {
+    std::string labels;
+    for (Key c : word) {
+      for (std::size_t j = 0; j < LABELS_PER_CHAR; ++j) {
+        labels.push_back(static_cast<char>(m_label(c, j)));
+      }
+    }
+    return labels;
+  }
 
   /**
-   * @brief Helper function to clone a trie structure
-   *
-   * @param from_node Source node to clone from
-   * @param to_node Destination node to clone to
+   * @brief Reassemble the characters spelt by `labels` into `out`
    */
-  void clone(std::unique_ptr<TrieNode> const &from_node,
-             std::unique_ptr<TrieNode> &to_node) {
-    to_node->end_of_word = from_node->end_of_word;
-    for (auto &[c, child_node] : from_node->children) {
-      auto &dest_child = to_node->children[c];
-      if (!dest_child)
-        dest_child = std::make_unique<TrieNode>();
-      clone(child_node, dest_child);
+  static void m_decode(std::string_view labels, std::basic_string<Key> &out) {
+    out.clear();
+    for (std::size_t i = 0; i < labels.size(); i += LABELS_PER_CHAR) {
+      unit_type u = 0;
+      for (std::size_t j = 0; j < LABELS_PER_CHAR; ++j) {
+        u = static_cast<unit_type>(static_cast<unit_type>(u << LABEL_BITS) |
+                                   static_cast<std::uint8_t>(labels[i + j]));
+      }
+      out.push_back(static_cast<Key>(u));
     }
   }
 
 public:
+  /** @brief The types of a word and of a view of one */
+  using string_type = std::basic_string<Key>;
+  using view_type = std::basic_string_view<Key>;
+
+  /** @brief How many words is_word_batch() walks in lockstep */
+  static constexpr std::size_t BATCH_LANES = 16;
+
+  /** @brief The type of a word's score, used to rank completions */
+  using score_type = std::uint32_t;
+
+  /**
+   * @brief An input iterator over the words below a node, in lexicographic (byte)
+   * order. Words are produced one at a time by an explicit depth-first walk, so
+   * nothing is materialized up front; the string_view it yields is only valid
+   * until the iterator is advanced.
+   */
+  class completion_iterator {
+    struct Frame {
+      index_type node;
+      std::uint32_t depth;
+      std::uint8_t label;
+    };
+
+    TrieNodePool const *m_nodes{nullptr};
+    std::vector<Frame> m_stack;
+    // The labels along the current path, and the word they spell unless PLAIN
+    std::string m_labels;
+    string_type m_word;
+    bool m_done{true};
+
+    void m_spell() {
+      if constexpr (!PLAIN) {
+        m_decode(m_labels, m_word);
+      }
+    }
+
+    void m_push_children(index_type node, std::size_t depth) {
+      std::size_t const first = m_stack.size();
+      m_nodes->for_each_child(node, [&](std::uint8_t label, index_type child) {
+        m_stack.push_back(Frame{child, static_cast<std::uint32_t>(depth + 1), label});
+      });
+      // Pop in ascending label order
+      std::reverse(m_stack.begin() + static_cast<std::ptrdiff_t>(first), m_stack.end());
+    }
+
+    void m_advance() {
+      while (!m_stack.empty()) {
+        Frame const f = m_stack.back();
+        m_stack.pop_back();
+        m_labels.resize(f.depth - 1);
+        m_labels.push_back(static_cast<char>(f.label));
+        m_push_children(f.node, f.depth);
+        if (m_nodes->terminal(f.node)) {
+          m_spell();
+          return;
+        }
+      }
+      m_done = true;
+    }
+
+  public:
+    using iterator_concept = std::input_iterator_tag;
+    using value_type = view_type;
+    using difference_type = std::ptrdiff_t;
+
+    /**
+     * @brief An exhausted iterator
+     */
+    completion_iterator() = default;
+
+    /**
+     * @brief Iterate the words below `start`, whose path is labelled `prefix`
+     *
+     * @param nodes The node pool
+     * @param start The node to enumerate, or NONE for an empty range
+     * @param prefix The labels leading to `start`
+     */
+    completion_iterator(TrieNodePool const &nodes, index_type start,
+                        std::string_view prefix)
+        : m_nodes(&nodes), m_labels(prefix), m_done(start == TrieNodePool::NONE) {
+      if (m_done) {
+        return;
+      }
+      m_push_children(start, prefix.size());
+      if (nodes.terminal(start)) {
+        m_spell();
+      } else {
+        m_advance();
+      }
+    }
+
+    view_type operator*() const noexcept {
+      if constexpr (PLAIN) {
+        return m_labels;
+      } else {
+        return m_word;
+      }
+    }
+
+    completion_iterator &operator++() {
+      m_advance();
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(completion_iterator const &it,
+                           std::default_sentinel_t) noexcept {
+      return it.m_done;
+    }
+  };
+
+  /**
+   * @brief The words of a trie that start with a prefix, as a lazy range
+   */
+  class completion_range {
+    TrieNodePool const *m_nodes;
+    index_type m_start;
+    std::string m_prefix;
+
+  public:
+    completion_range(TrieNodePool const &nodes, index_type start,
+                     std::string_view prefix)
+        : m_nodes(&nodes), m_start(start), m_prefix(prefix) {}
+
+    [[nodiscard]] completion_iterator begin() const {
+      return completion_iterator(*m_nodes, m_start, m_prefix);
+    }
+
+    [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+  };
+
   /**
    * @brief Construct a new empty Trie
    */
-  Trie() noexcept : m_root(std::make_unique<TrieNode>()) {}
+  Trie() = default;
 
   /**
    * @brief Construct a Trie with initial words
    *
    * @param list List of words to insert into the trie
    */
-  Trie(std::initializer_list<std::string_view> list)
-      : m_root(std::make_unique<TrieNode>()) {
+  Trie(std::initializer_list<view_type> list) {
     for (auto const &str : list) {
       insert(str);
     }
   }
 
   /**
-   * @brief Destructor
+   * @brief Insert a word into the trie
+   *
+   * @param word The word to insert
    */
-  ~Trie() noexcept = default;
+  void insert(view_type word) { m_nodes.set_terminal(m_emplace(word, nullptr), true); }
 
   /**
-   * @brief Copy constructor
+   * @brief Insert a word given as a range of characters
    *
-   * @param other Trie to copy from
+   * @param word The word to insert
    */
-  Trie(Trie const &other) noexcept : Trie() { clone(other.m_root, m_root); }
+  template <TrieKeyRange<Key> R>
+  void insert(R &&word) {
+    m_nodes.set_terminal(m_emplace(word, nullptr), true);
+  }
 
   /**
-   * @brief Move constructor
+   * @brief Insert a word with a score, or set the score of an existing word. Words
+   * inserted without a score have score 0. Each node also records the highest
+   * score in its subtree, which is what lets top_k() skip whole branches.
    *
-   * @param other Trie to move from
+   * @param word The word to insert
+   * @param score The word's score; higher ranks first
    */
-  Trie(Trie &&other) noexcept : m_root(std::exchange(other.m_root, nullptr)) {}
+  void insert(view_type word, score_type score) {
+    std::vector<index_type> path;
+    path.reserve(word.size() * LABELS_PER_CHAR + 1);
+    index_type const node = m_emplace(word, &path);
+    m_score.resize(m_nodes.index_bound(), 0);
+    m_best.resize(m_nodes.index_bound(), 0);
+
+    score_type const old = m_nodes.terminal(node) ? m_score[node] : 0;
+    m_nodes.set_terminal(node, true);
+    m_score[node] = score;
+    if (score >= old) {
+      for (index_type n : path) {
+        m_best[n] = std::max(m_best[n], score);
+      }
+      return;
+    }
+    // The score went down: recompute the maxima bottom-up until one is unchanged
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+      score_type best = m_nodes.terminal(*it) ? m_score[*it] : 0;
+      m_nodes.for_each_child(*it, [&](std::uint8_t, index_type child) {
+        best = std::max(best, m_best_of(child));
+      });
+      if (best == m_best[*it]) {
+        break;
+      }
+      m_best[*it] = best;
+    }
+  }
 
   /**
-   * @brief Copy assignment operator
+   * @brief Get the score of a word
    *
-   * @param other Trie to copy from
-   * @return Trie& Reference to this object
+   * @param word The word to look up
+   * @return score_type Its score, or 0 if it is unscored or not in the trie
    */
-  Trie &operator=(Trie const &other) noexcept {
-    if (this == &other) {
-      return *this;
-    }
-    return *this = Trie(other);
+  [[nodiscard]] score_type score(view_type word) const noexcept {
+    index_type const node = m_walk(word);
+    return node != TrieNodePool::NONE && m_nodes.terminal(node) ? m_score_of(node) : 0;
   }
 
   /**
-   * @brief Move assignment operator
+   * @brief Check if a word exists in the trie
    *
-   * @param other Trie to move from
-   * @return Trie& Reference to this object
+   * @param word The word to check for
+   * @return true If the word exists in the trie
+   * @return false If the word does not exist in the trie
    */
-  Trie &operator=(Trie &&other) noexcept {
-    std::swap(m_root, other.m_root);
-    return *this;
+  [[nodiscard]] bool is_word(view_type word) const noexcept {
+    index_type const node = m_walk(word);
+    return node != TrieNodePool::NONE && m_nodes.terminal(node);
   }
 
   /**
-   * @brief Insert a word into the trie
+   * @brief Check if a word given as a range of characters exists in the trie
    *
-   * @param word The word to insert
+   * @param word The word to check for
    */
-  void insert(std::string_view word) noexcept {
-    auto *root = m_root.get();
-    for (auto const &c : word) {
-      auto it = root->children.find(c);
-      if (it == root->children.end()) {
-        root->children[c] = std::make_unique<TrieNode>();
-      }
-      root = root->children[c].get();
-    }
-    root->end_of_word = true;
+  template <TrieKeyRange<Key> R>
+  [[nodiscard]] bool is_word(R &&word) const {
+    index_type const node = m_walk(word);
+    return node != TrieNodePool::NONE && m_nodes.terminal(node);
   }
 
   /**
-   * @brief Check if a word exists in the trie
+   * @brief Check many words at once, e.g. every token of a document
    *
-   * @param word The word to check for
-   * @return true If the word exists in the trie
-   * @return false If the word does not exist in the trie
+   * Words are walked in groups of BATCH_LANES, one label per word per round. Each
+   * round first prefetches what every lane's next lookup will touch, then performs
+   * the lookups, so the cache misses of the whole group overlap instead of being
+   * paid one after another.
+   *
+   * @param words The words to check for
+   * @param out Receives, at the same position, whether each word is in the trie
+   * @return std::size_t The number of words found
+   * @throws std::invalid_argument If `out` is shorter than `words`
    */
-  [[nodiscard]] bool is_word(std::string_view word) const noexcept {
-    auto *root = m_root.get();
-    for (auto const &c : word) {
-      auto it = root->children.find(c);
-      if (it == root->children.end()) {
-        return false;
+  std::size_t is_word_batch(std::span<view_type const> words,
+                            std::span<bool> out) const {
+    if (out.size() < words.size()) {
+      throw std::invalid_argument("Output span is too small!");
+    }
+
+    std::size_t found = 0;
+    index_type node[BATCH_LANES];
+    for (std::size_t base = 0; base < words.size(); base += BATCH_LANES) {
+      std::size_t const lanes = std::min(BATCH_LANES, words.size() - base);
+      view_type const *group = words.data() + base;
+      std::fill_n(node, lanes, TrieNodePool::ROOT);
+
+      bool active = true;
+      for (std::size_t depth = 0; active; ++depth) {
+        auto const length = [&](std::size_t i) {
+          return group[i].size() * LABELS_PER_CHAR;
+        };
+        auto const label = [&](std::size_t i) {
+          return m_label(group[i][depth / LABELS_PER_CHAR], depth % LABELS_PER_CHAR);
+        };
+        for (std::size_t i = 0; i < lanes; ++i) {
+          if (node[i] != TrieNodePool::NONE && depth < length(i)) {
+            m_nodes.prefetch_child(node[i], label(i));
+          }
+        }
+        active = false;
+        for (std::size_t i = 0; i < lanes; ++i) {
+          if (node[i] == TrieNodePool::NONE || depth >= length(i)) {
+            continue;
+          }
+          node[i] = m_nodes.child(node[i], label(i));
+          if (node[i] != TrieNodePool::NONE && depth + 1 < length(i)) {
+            m_nodes.prefetch(node[i]);
+            active = true;
+          }
+        }
+      }
+
+      for (std::size_t i = 0; i < lanes; ++i) {
+        bool const hit = node[i] != TrieNodePool::NONE && m_nodes.terminal(node[i]);
+        out[base + i] = hit;
+        found += hit;
       }
-      root = it->second.get();
     }
-    return root->end_of_word;
+    return found;
   }
 
   /**
@@ -165,23 +435,228 @@ public:
    * @return true If the prefix exists in the trie
    * @return false If no word in the trie starts with the prefix
    */
-  [[nodiscard]] bool starts_with(std::string_view prefix) const noexcept {
-    auto *root = m_root.get();
-    for (auto const &c : prefix) {
-      auto it = root->children.find(c);
-      if (it == root->children.end()) {
-        return false;
+  [[nodiscard]] bool starts_with(view_type prefix) const noexcept {
+    return m_walk(prefix) != TrieNodePool::NONE;
+  }
+
+  /**
+   * @brief Check if any word starts with a prefix given as a range of characters
+   *
+   * @param prefix The prefix to check for
+   */
+  template <TrieKeyRange<Key> R>
+  [[nodiscard]] bool starts_with(R &&prefix) const {
+    return m_walk(prefix) != TrieNodePool::NONE;
+  }
+
+  /**
+   * @brief Get the words that start with `prefix` as a lazy range, in lexicographic
+   * order of their characters taken as unsigned integers
+   *
+   * @param prefix The prefix to complete
+   * @return completion_range A range of view_type, each valid until the iterator
+   * is advanced
+   */
+  [[nodiscard]] completion_range completions(view_type prefix) const {
+    index_type const start = m_walk(prefix);
+    if constexpr (PLAIN) {
+      return completion_range(m_nodes, start, prefix);
+    } else {
+      return completion_range(m_nodes, start, m_encode(prefix));
+    }
+  }
+
+  /**
+   * @brief Call `f` with every word that starts with `prefix`, in the order of
+   * completions(). The view passed to `f` is only valid during the call.
+   *
+   * @param prefix The prefix to complete
+   * @param f Called as f(view_type word)
+   */
+  template <typename F>
+  void for_each_with_prefix(view_type prefix, F &&f) const {
+    for (view_type word : completions(prefix)) {
+      f(word);
+    }
+  }
+
+  /**
+   * @brief Get the `k` highest-scoring words that start with `prefix`, best first,
+   * ties in lexicographic order
+   *
+   * A best-first search ordered by each subtree's maximum score: a branch is only
+   * opened once nothing outside it can beat it, so the cost depends on `k` and the
+   * depth of the results rather than on the size of the subtree.
+   *
+   * @param prefix The prefix to complete
+   * @param k The number of words to return at most
+   * @return std::vector<std::pair<string_type, score_type>> The words and their scores
+   */
+  [[nodiscard]] std::vector<std::pair<string_type, score_type>>
+  top_k(view_type prefix, std::size_t k) const {
+    std::vector<std::pair<string_type, score_type>> result;
+    index_type const start = m_walk(prefix);
+    if (start == TrieNodePool::NONE || k == 0) {
+      return result;
+    }
+
+    struct Candidate {
+      // The subtree's maximum score, or the word's score when `word` is set
+      score_type bound;
+      bool word;
+      index_type node;
+      // The labels leading to `node`
+      std::string text;
+    };
+    auto const worse = [](Candidate const &a, Candidate const &b) {
+      if (a.bound != b.bound) {
+        return a.bound < b.bound;
+      }
+      if (a.text != b.text) {
+        return a.text > b.text;
+      }
+      return !a.word && b.word;
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(worse)> queue(
+        worse);
+    queue.push(Candidate{m_best_of(start), false, start, m_encode(prefix)});
+
+    while (!queue.empty() && result.size() < k) {
+      Candidate c = queue.top();
+      queue.pop();
+      if (c.word) {
+        if constexpr (PLAIN) {
+          result.emplace_back(std::move(c.text), c.bound);
+        } else {
+          m_decode(c.text, result.emplace_back(string_type{}, c.bound).first);
+        }
+        continue;
       }
-      root = it->second.get();
+      if (m_nodes.terminal(c.node)) {
+        queue.push(Candidate{m_score_of(c.node), true, c.node, c.text});
+      }
+      m_nodes.for_each_child(c.node, [&](std::uint8_t label, index_type child) {
+        std::string text = c.text;
+        text.push_back(static_cast<char>(label));
+        queue.push(Candidate{m_best_of(child), false, child, std::move(text)});
+      });
     }
-    return true;
+    return result;
+  }
+
+  /**
+   * @brief Build an immutable, succinct copy of the trie that supports the same
+   * queries plus prefix enumeration, and can be saved and memory-mapped
+   *
+   * @return LoudsTrie The frozen trie
+   */
+  [[nodiscard]] LoudsTrie freeze() const
+    requires PLAIN
+  {
+    return LoudsTrie(m_nodes);
+  }
+
+  /**
+   * @brief Build an Aho-Corasick automaton whose patterns are the words of the
+   * trie, for finding all of them in a text in a single pass
+   *
+   * @return AhoCorasick The compiled matcher; it does not refer back to the trie
+   */
+  [[nodiscard]] AhoCorasick compile() const
+    requires PLAIN
+  {
+    return AhoCorasick(m_nodes);
+  }
+
+  /**
+   * @brief Remove every word. Nodes live in flat pools linked by index, so this
+   * resets the pools without visiting the nodes and keeps their memory for reuse.
+   */
+  void clear() noexcept {
+    m_nodes.clear();
+    m_score.clear();
+    m_best.clear();
+  }
+
+  /**
+   * @brief Get the number of nodes in the trie, including the root
+   */
+  [[nodiscard]] std::size_t node_count() const noexcept { return m_nodes.node_count(); }
+
+  /**
+   * @brief Get the number of bytes reserved for the trie's nodes
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_nodes.memory_usage() +
+           (m_score.capacity() + m_best.capacity()) * sizeof(score_type);
   }
 
 private:
-  /** @brief Root node of the trie */
-  std::unique_ptr<TrieNode> m_root;
+  /** @brief All nodes of the trie; index ROOT is the root */
+  TrieNodePool m_nodes;
+  /** @brief Per-node word score; empty until a scored insert, short entries are 0 */
+  std::vector<score_type> m_score;
+  /** @brief Per-node maximum score within the subtree, same indexing as m_score */
+  std::vector<score_type> m_best;
+
+  score_type m_score_of(index_type node) const noexcept {
+    return node < m_score.size() ? m_score[node] : 0;
+  }
+
+  score_type m_best_of(index_type node) const noexcept {
+    return node < m_best.size() ? m_best[node] : 0;
+  }
+
+  /**
+   * @brief Follow `word` from the root
+   *
+   * @return index_type The node it leads to, or NONE
+   */
+  template <typename R>
+  index_type m_walk(R &&word) const {
+    if constexpr (PLAIN) {
+      return m_nodes.walk(TrieNodePool::ROOT, std::ranges::begin(word),
+                          std::ranges::end(word));
+    } else {
+      index_type node = TrieNodePool::ROOT;
+      for (Key c : word) {
+        for (std::size_t j = 0; j < LABELS_PER_CHAR; ++j) {
+          node = m_nodes.child(node, m_label(c, j));
+          if (node == TrieNodePool::NONE) {
+            return node;
+          }
+        }
+      }
+      return node;
+    }
+  }
+
+  /**
+   * @brief Create the path spelling `word`, optionally recording it from the root
+   *
+   * @return index_type The node at the end of the path
+   */
+  template <typename R>
+  index_type m_emplace(R &&word, std::vector<index_type> *path) {
+    index_type node = TrieNodePool::ROOT;
+    if (path) {
+      path->push_back(node);
+    }
+    for (Key c : word) {
+      for (std::size_t j = 0; j < LABELS_PER_CHAR; ++j) {
+        node = m_nodes.emplace_child(node, m_label(c, j));
+        if (path) {
+          path->push_back(node);
+        }
+      }
+    }
+    return node;
+  }
 };
 
+/** @brief Deduce a Trie<char> from a list of string literals */
+Trie(std::initializer_list<std::string_view>) -> Trie<char>;
+
 } // namespace ming
 
 #endif // MING_TRIE
\ No newline at end of file
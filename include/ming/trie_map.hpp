@@ -0,0 +1,288 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_TRIE_MAP
+#define MING_TRIE_MAP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ming/trie_node_pool.hpp>
+
+namespace ming {
+
+/**
+ * @brief A map from strings to values, stored as a trie
+ *
+ * Keys share their common prefixes in a TrieNodePool, so no key is stored as a
+ * string of its own. Values are kept densely in one array, and a node that ends
+ * a key refers to its value by index. Erasing a key prunes the branch that only
+ * led to it and hands those nodes back to the pool.
+ *
+ * Keys are byte strings (std::string_view).
+ *
+ * @tparam V The mapped type
+ */
+template <typename V>
+class TrieMap {
+  using index_type = TrieNodePool::index_type;
+
+  /** @brief All nodes of the trie; index ROOT is the root */
+  TrieNodePool m_nodes;
+  /** @brief Per-node index into m_values, or NONE if no key ends at the node */
+  std::vector<index_type> m_slot{TrieNodePool::NONE};
+  /** @brief The values, densely packed */
+  std::vector<V> m_values;
+  /** @brief The node owning each value, to patch m_slot when values move */
+  std::vector<index_type> m_owner;
+
+  static std::uint8_t m_byte(char c) noexcept { return static_cast<std::uint8_t>(c); }
+
+  index_type m_find(std::string_view key) const noexcept {
+    index_type const node = m_nodes.walk(TrieNodePool::ROOT, key.begin(), key.end());
+    return node == TrieNodePool::NONE ? TrieNodePool::NONE : m_slot[node];
+  }
+
+  V *m_value(index_type slot) noexcept {
+    return slot == TrieNodePool::NONE ? nullptr : &m_values[slot];
+  }
+
+  V const *m_value(index_type slot) const noexcept {
+    return slot == TrieNodePool::NONE ? nullptr : &m_values[slot];
+  }
+
+  template <typename M>
+  std::pair<V *, bool> m_assign(std::string_view key, M &&obj) {
+    index_type node = TrieNodePool::ROOT;
+    for (auto const &c : key) {
+      node = m_nodes.emplace_child(node, m_byte(c));
+    }
+    m_slot.resize(m_nodes.index_bound(), TrieNodePool::NONE);
+
+    if (index_type const slot = m_slot[node]; slot != TrieNodePool::NONE) {
+      m_values[slot] = std::forward<M>(obj);
+      return {&m_values[slot], false};
+    }
+    m_values.emplace_back(std::forward<M>(obj));
+    m_owner.push_back(node);
+    m_slot[node] = static_cast<index_type>(m_values.size() - 1);
+    m_nodes.set_terminal(node, true);
+    return {&m_values.back(), true};
+  }
+
+public:
+  /**
+   * @brief Construct a new empty TrieMap
+   */
+  TrieMap() = default;
+
+  /**
+   * @brief Insert a key with a value, or assign the value if the key exists
+   *
+   * @param key The key
+   * @param obj The value
+   * @return std::pair<V *, bool> A pointer to the stored value, and whether the key
+   * was inserted (true) or assigned (false)
+   */
+  std::pair<V *, bool> insert_or_assign(std::string_view key, V const &obj) {
+    return m_assign(key, obj);
+  }
+
+  /**
+   * @brief Insert a key with a value, or assign the value if the key exists
+   *
+   * @param key The key
+   * @param obj The value, moved into the map
+   * @return std::pair<V *, bool> A pointer to the stored value, and whether the key
+   * was inserted (true) or assigned (false)
+   */
+  std::pair<V *, bool> insert_or_assign(std::string_view key, V &&obj) {
+    return m_assign(key, std::move(obj));
+  }
+
+  /**
+   * @brief Find the value of a key. The pointer is invalidated by any insertion or
+   * erasure.
+   *
+   * @param key The key to find
+   * @return V* The value, or nullptr if the key is not in the map
+   */
+  [[nodiscard]] V *find(std::string_view key) noexcept {
+    return m_value(m_find(key));
+  }
+
+  /**
+   * @brief Find the value of a key. The pointer is invalidated by any insertion or
+   * erasure.
+   *
+   * @param key The key to find
+   * @return V const* The value, or nullptr if the key is not in the map
+   */
+  [[nodiscard]] V const *find(std::string_view key) const noexcept {
+    return m_value(m_find(key));
+  }
+
+  /**
+   * @brief Check if a key is in the map
+   */
+  [[nodiscard]] bool contains(std::string_view key) const noexcept {
+    return m_find(key) != TrieNodePool::NONE;
+  }
+
+  /**
+   * @brief Find the longest key in the map that is a prefix of `key`, as for a
+   * routing table lookup
+   *
+   * @param key The key to match
+   * @return std::pair<std::string_view, V *> The matching prefix of `key` and its
+   * value, or an empty view and nullptr if no key is a prefix of `key`
+   */
+  [[nodiscard]] std::pair<std::string_view, V *>
+  longest_prefix_match(std::string_view key) noexcept {
+    auto const [length, slot] = m_longest(key);
+    return {key.substr(0, length), m_value(slot)};
+  }
+
+  /**
+   * @brief Find the longest key in the map that is a prefix of `key`, as for a
+   * routing table lookup
+   *
+   * @param key The key to match
+   * @return std::pair<std::string_view, V const *> The matching prefix of `key` and
+   * its value, or an empty view and nullptr if no key is a prefix of `key`
+   */
+  [[nodiscard]] std::pair<std::string_view, V const *>
+  longest_prefix_match(std::string_view key) const noexcept {
+    auto const [length, slot] = m_longest(key);
+    return {key.substr(0, length), m_value(slot)};
+  }
+
+  /**
+   * @brief Remove a key, pruning the nodes that only led to it
+   *
+   * @param key The key to remove
+   * @return true If the key was removed
+   * @return false If the key was not in the map
+   */
+  bool erase(std::string_view key) {
+    // The deepest node on the path that must survive (the root, a node that ends
+    // another key, or one that branches), and the label leading out of it
+    index_type keep = TrieNodePool::ROOT;
+    std::size_t cut = 0;
+    index_type node = TrieNodePool::ROOT;
+    for (std::size_t i = 0; i < key.size(); ++i) {
+      if (m_slot[node] != TrieNodePool::NONE || m_nodes.child_count(node) > 1) {
+        keep = node;
+        cut = i;
+      }
+      node = m_nodes.child(node, m_byte(key[i]));
+      if (node == TrieNodePool::NONE) {
+        return false;
+      }
+    }
+    index_type const slot = m_slot[node];
+    if (slot == TrieNodePool::NONE) {
+      return false;
+    }
+
+    // Fill the hole with the last value so the array stays dense
+    if (std::size_t const last = m_values.size() - 1; slot != last) {
+      m_values[slot] = std::move(m_values[last]);
+      m_owner[slot] = m_owner[last];
+      m_slot[m_owner[slot]] = slot;
+    }
+    m_values.pop_back();
+    m_owner.pop_back();
+    m_slot[node] = TrieNodePool::NONE;
+    m_nodes.set_terminal(node, false);
+
+    if (m_nodes.child_count(node) > 0 || node == TrieNodePool::ROOT) {
+      return true;
+    }
+    // Everything below `keep` along the key is a chain leading only to `node`
+    index_type doomed = m_nodes.child(keep, m_byte(key[cut]));
+    m_nodes.remove_child(keep, m_byte(key[cut]));
+    for (std::size_t i = cut + 1; i <= key.size(); ++i) {
+      index_type const next = i < key.size() ? m_nodes.child(doomed, m_byte(key[i]))
+                                             : TrieNodePool::NONE;
+      if (next != TrieNodePool::NONE) {
+        m_nodes.remove_child(doomed, m_byte(key[i]));
+      }
+      m_nodes.free_node(doomed);
+      doomed = next;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Get the number of keys in the map
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return m_values.size(); }
+
+  /**
+   * @brief Check if the map is empty
+   */
+  [[nodiscard]] bool empty() const noexcept { return m_values.empty(); }
+
+  /**
+   * @brief Remove every key
+   */
+  void clear() noexcept {
+    m_nodes.clear();
+    m_slot.assign(1, TrieNodePool::NONE);
+    m_values.clear();
+    m_owner.clear();
+  }
+
+  /**
+   * @brief Get the number of nodes in the trie, including the root
+   */
+  [[nodiscard]] std::size_t node_count() const noexcept { return m_nodes.node_count(); }
+
+  /**
+   * @brief Get the number of bytes reserved for nodes and values, not counting any
+   * memory the values own themselves
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_nodes.memory_usage() + m_slot.capacity() * sizeof(index_type) +
+           m_values.capacity() * sizeof(V) + m_owner.capacity() * sizeof(index_type);
+  }
+
+private:
+  std::pair<std::size_t, index_type> m_longest(std::string_view key) const noexcept {
+    std::pair<std::size_t, index_type> best{0, m_slot[TrieNodePool::ROOT]};
+    index_type node = TrieNodePool::ROOT;
+    for (std::size_t i = 0; i < key.size(); ++i) {
+      node = m_nodes.child(node, m_byte(key[i]));
+      if (node == TrieNodePool::NONE) {
+        break;
+      }
+      if (m_slot[node] != TrieNodePool::NONE) {
+        best = {i + 1, m_slot[node]};
+      }
+    }
+    return best;
+  }
+};
+
+} // namespace ming
+
+#endif // MING_TRIE_MAP
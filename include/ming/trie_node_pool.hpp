@@ -0,0 +1,670 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_TRIE_NODE_POOL
+#define MING_TRIE_NODE_POOL
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ming {
+
+/**
+ * @brief Storage for the nodes of a byte-labelled trie, addressed by 32-bit
+ * indices instead of pointers.
+ *
+ * Every node has an 8-byte header. Its children live in one of several
+ * representations that grow with the fan-out, in the spirit of the adaptive radix
+ * tree:
+ *
+ *   - one child is stored inline in the header, so single-child chains cost no
+ *     extra memory or cache miss;
+ *   - up to 4 or 16 children live in sorted label/child arrays, the 16-way
+ *     one searched with a single SSE2 compare where available;
+ *   - up to 48 children use a 256-entry byte index into a 48-slot child array;
+ *   - denser nodes use a direct 256-entry child table.
+ *
+ * Each representation has its own pool with a free list, so a node that outgrows
+ * its array hands the old slot back for reuse. Removing children shrinks a node
+ * back down, and unlinked nodes can be freed for reuse by later insertions.
+ *
+ * The pools are monotonic arenas in all but name: all storage is trivially
+ * copyable and linked by index, so copying a pool is one memcpy per pool,
+ * destroying or clearing it releases each pool at once, and neither walks the
+ * nodes, let alone recursively, however long the keys.
+ *
+ * @see https://db.in.tum.de/~leis/papers/ART.pdf
+ */
+class TrieNodePool {
+public:
+  using index_type = std::uint32_t;
+
+  /** @brief Index standing for "no node" */
+  static constexpr index_type NONE = std::numeric_limits<index_type>::max();
+
+  /** @brief Index of the root node, which always exists */
+  static constexpr index_type ROOT = 0;
+
+private:
+  enum Kind : std::uint8_t { EMPTY, ONE, FOUR, SIXTEEN, FORTY_EIGHT, FULL };
+
+  struct Node {
+    // ONE: the child itself; FOUR and up: the slot in the matching pool
+    index_type slot{NONE};
+    std::uint16_t count : 15 {0};
+    std::uint16_t terminal : 1 {0};
+    std::uint8_t kind{EMPTY};
+    // ONE: the label of the inline child
+    std::uint8_t label{0};
+  };
+
+  static_assert(sizeof(Node) == 8);
+
+  template <std::size_t N>
+  struct Sorted {
+    std::uint8_t labels[N];
+    index_type children[N];
+  };
+
+  struct Indexed {
+    // 0 for no child, otherwise 1 + the position in `children`
+    std::uint8_t index[256];
+    index_type children[48];
+  };
+
+  struct Direct {
+    index_type children[256];
+  };
+
+  template <typename T>
+  struct Pool {
+    std::vector<T> items;
+    std::vector<index_type> free;
+
+    index_type acquire() {
+      if (!free.empty()) {
+        index_type slot = free.back();
+        free.pop_back();
+        return slot;
+      }
+      items.emplace_back();
+      return static_cast<index_type>(items.size() - 1);
+    }
+
+    void release(index_type slot) { free.push_back(slot); }
+
+    void clear() noexcept {
+      items.clear();
+      free.clear();
+    }
+
+    std::size_t memory_usage() const noexcept {
+      return items.capacity() * sizeof(T) + free.capacity() * sizeof(index_type);
+    }
+  };
+
+  std::vector<Node> m_nodes;
+  std::vector<index_type> m_free_nodes;
+  Pool<Sorted<4>> m_four;
+  Pool<Sorted<16>> m_sixteen;
+  Pool<Indexed> m_forty_eight;
+  Pool<Direct> m_full;
+
+  template <std::size_t N>
+  static index_type m_find_sorted(Sorted<N> const &s, std::size_t count,
+                                  std::uint8_t label) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (s.labels[i] == label) {
+        return s.children[i];
+      }
+    }
+    return NONE;
+  }
+
+  /**
+   * @brief Search a 16-way node with one SSE2 compare of all its labels
+   */
+  static index_type m_find_sorted(Sorted<16> const &s, std::size_t count,
+                                  std::uint8_t label) noexcept {
+#if defined(__SSE2__)
+    __m128i const labels = _mm_loadu_si128(reinterpret_cast<__m128i const *>(s.labels));
+    __m128i const hits =
+        _mm_cmpeq_epi8(labels, _mm_set1_epi8(static_cast<char>(label)));
+    // Labels past `count` are stale; mask them off
+    unsigned const mask =
+        static_cast<unsigned>(_mm_movemask_epi8(hits)) & ((1u << count) - 1);
+    return mask ? s.children[std::countr_zero(mask)] : NONE;
+#else
+    for (std::size_t i = 0; i < count; ++i) {
+      if (s.labels[i] == label) {
+        return s.children[i];
+      }
+    }
+    return NONE;
+#endif
+  }
+
+  static void m_prefetch([[maybe_unused]] void const *p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#endif
+  }
+
+  template <std::size_t N>
+  static void m_insert_sorted(Sorted<N> &s, std::size_t count, std::uint8_t label,
+                              index_type child) noexcept {
+    std::size_t i = count;
+    while (i > 0 && s.labels[i - 1] > label) {
+      s.labels[i] = s.labels[i - 1];
+      s.children[i] = s.children[i - 1];
+      --i;
+    }
+    s.labels[i] = label;
+    s.children[i] = child;
+  }
+
+  template <std::size_t N>
+  static void m_replace_sorted(Sorted<N> &s, std::size_t count, std::uint8_t label,
+                               index_type child) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (s.labels[i] == label) {
+        s.children[i] = child;
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Add a child that is known not to exist, growing the node's
+   * representation when it is full
+   */
+  void m_link(index_type node, std::uint8_t label, index_type child) {
+    Node &n = m_nodes[node];
+    switch (n.kind) {
+    case EMPTY:
+      n.kind = ONE;
+      n.label = label;
+      n.slot = child;
+      break;
+    case ONE: {
+      index_type const slot = m_four.acquire();
+      auto &s = m_four.items[slot];
+      s.labels[0] = n.label;
+      s.children[0] = n.slot;
+      m_insert_sorted(s, 1, label, child);
+      n.kind = FOUR;
+      n.slot = slot;
+      break;
+    }
+    case FOUR: {
+      if (n.count < 4) {
+        m_insert_sorted(m_four.items[n.slot], n.count, label, child);
+        break;
+      }
+      index_type const slot = m_sixteen.acquire();
+      auto &from = m_four.items[n.slot];
+      auto &to = m_sixteen.items[slot];
+      std::copy_n(from.labels, 4, to.labels);
+      std::copy_n(from.children, 4, to.children);
+      m_insert_sorted(to, 4, label, child);
+      m_four.release(n.slot);
+      n.kind = SIXTEEN;
+      n.slot = slot;
+      break;
+    }
+    case SIXTEEN: {
+      if (n.count < 16) {
+        m_insert_sorted(m_sixteen.items[n.slot], n.count, label, child);
+        break;
+      }
+      index_type const slot = m_forty_eight.acquire();
+      auto &from = m_sixteen.items[n.slot];
+      auto &to = m_forty_eight.items[slot];
+      std::fill_n(to.index, 256, 0);
+      for (std::uint8_t i = 0; i < 16; ++i) {
+        to.index[from.labels[i]] = static_cast<std::uint8_t>(i + 1);
+        to.children[i] = from.children[i];
+      }
+      to.index[label] = 17;
+      to.children[16] = child;
+      m_sixteen.release(n.slot);
+      n.kind = FORTY_EIGHT;
+      n.slot = slot;
+      break;
+    }
+    case FORTY_EIGHT: {
+      auto &from = m_forty_eight.items[n.slot];
+      if (n.count < 48) {
+        from.index[label] = static_cast<std::uint8_t>(n.count + 1);
+        from.children[n.count] = child;
+        break;
+      }
+      index_type const slot = m_full.acquire();
+      auto &to = m_full.items[slot];
+      std::fill_n(to.children, 256, NONE);
+      for (std::size_t c = 0; c < 256; ++c) {
+        if (from.index[c]) {
+          to.children[c] = from.children[from.index[c] - 1];
+        }
+      }
+      to.children[label] = child;
+      m_forty_eight.release(n.slot);
+      n.kind = FULL;
+      n.slot = slot;
+      break;
+    }
+    default:
+      m_full.items[n.slot].children[label] = child;
+      break;
+    }
+    ++n.count;
+  }
+
+  template <std::size_t N>
+  static void m_erase_sorted(Sorted<N> &s, std::size_t count,
+                             std::uint8_t label) noexcept {
+    std::size_t i = 0;
+    while (i < count && s.labels[i] != label) {
+      ++i;
+    }
+    for (; i + 1 < count; ++i) {
+      s.labels[i] = s.labels[i + 1];
+      s.children[i] = s.children[i + 1];
+    }
+  }
+
+  /**
+   * @brief Rebuild `node` in the smallest representation for its children; used
+   * when removals leave it well below its capacity
+   */
+  void m_shrink(index_type node) {
+    std::uint8_t labels[256];
+    index_type children[256];
+    std::size_t count = 0;
+    for_each_child(node, [&](std::uint8_t label, index_type child) {
+      labels[count] = label;
+      children[count] = child;
+      ++count;
+    });
+
+    Node &n = m_nodes[node];
+    switch (n.kind) {
+    case FOUR:
+      m_four.release(n.slot);
+      break;
+    case SIXTEEN:
+      m_sixteen.release(n.slot);
+      break;
+    case FORTY_EIGHT:
+      m_forty_eight.release(n.slot);
+      break;
+    case FULL:
+      m_full.release(n.slot);
+      break;
+    default:
+      break;
+    }
+    n.kind = EMPTY;
+    n.slot = NONE;
+    n.count = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      m_link(node, labels[i], children[i]);
+    }
+  }
+
+public:
+  /**
+   * @brief Construct a pool holding just the root
+   */
+  TrieNodePool() : m_nodes(1) {}
+
+  /**
+   * @brief Find the child of `node` along `label`
+   *
+   * @param node The parent node
+   * @param label The edge label
+   * @return index_type The child, or NONE if there is none
+   */
+  [[nodiscard]] index_type child(index_type node, std::uint8_t label) const noexcept {
+    Node const &n = m_nodes[node];
+    switch (n.kind) {
+    case EMPTY:
+      return NONE;
+    case ONE:
+      return n.label == label ? n.slot : NONE;
+    case FOUR:
+      return m_find_sorted(m_four.items[n.slot], n.count, label);
+    case SIXTEEN:
+      return m_find_sorted(m_sixteen.items[n.slot], n.count, label);
+    case FORTY_EIGHT: {
+      auto const &s = m_forty_eight.items[n.slot];
+      return s.index[label] ? s.children[s.index[label] - 1] : NONE;
+    }
+    default:
+      return m_full.items[n.slot].children[label];
+    }
+  }
+
+  /**
+   * @brief Start loading the header of `node` into cache
+   */
+  void prefetch(index_type node) const noexcept { m_prefetch(&m_nodes[node]); }
+
+  /**
+   * @brief Start loading the memory that child(node, label) will search. Reads the
+   * header of `node`, so prefetch() it some time before.
+   */
+  void prefetch_child(index_type node, std::uint8_t label) const noexcept {
+    Node const &n = m_nodes[node];
+    switch (n.kind) {
+    case FOUR:
+      m_prefetch(&m_four.items[n.slot]);
+      break;
+    case SIXTEEN:
+      m_prefetch(&m_sixteen.items[n.slot]);
+      break;
+    case FORTY_EIGHT:
+      m_prefetch(&m_forty_eight.items[n.slot].index[label]);
+      break;
+    case FULL:
+      m_prefetch(&m_full.items[n.slot].children[label]);
+      break;
+    default:
+      // EMPTY and ONE keep everything in the header
+      break;
+    }
+  }
+
+  /**
+   * @brief Create a node that is not linked anywhere yet
+   *
+   * @return index_type The new node
+   * @throws std::length_error If the 32-bit index space is exhausted
+   */
+  index_type create_node() {
+    if (!m_free_nodes.empty()) {
+      index_type const node = m_free_nodes.back();
+      m_free_nodes.pop_back();
+      return node;
+    }
+    if (m_nodes.size() >= NONE) {
+      throw std::length_error("TrieNodePool is full!");
+    }
+    m_nodes.emplace_back();
+    return static_cast<index_type>(m_nodes.size() - 1);
+  }
+
+  /**
+   * @brief Make `child` the child of `node` along `label`, which must be free
+   *
+   * @param node The parent node
+   * @param label The edge label
+   * @param child The node to link in
+   */
+  void add_child(index_type node, std::uint8_t label, index_type child) {
+    m_link(node, label, child);
+  }
+
+  /**
+   * @brief Point the existing edge of `node` along `label` at another node
+   *
+   * @param node The parent node
+   * @param label The edge label, which must already have a child
+   * @param child The new child
+   */
+  void replace_child(index_type node, std::uint8_t label, index_type child) noexcept {
+    Node &n = m_nodes[node];
+    switch (n.kind) {
+    case ONE:
+      n.slot = child;
+      break;
+    case FOUR:
+      m_replace_sorted(m_four.items[n.slot], n.count, label, child);
+      break;
+    case SIXTEEN:
+      m_replace_sorted(m_sixteen.items[n.slot], n.count, label, child);
+      break;
+    case FORTY_EIGHT: {
+      auto &s = m_forty_eight.items[n.slot];
+      s.children[s.index[label] - 1] = child;
+      break;
+    }
+    default:
+      m_full.items[n.slot].children[label] = child;
+      break;
+    }
+  }
+
+  /**
+   * @brief Find the child of `node` along `label`, creating it if needed
+   *
+   * @param node The parent node
+   * @param label The edge label
+   * @return index_type The existing or new child
+   * @throws std::length_error If the 32-bit index space is exhausted
+   */
+  index_type emplace_child(index_type node, std::uint8_t label) {
+    if (index_type existing = child(node, label); existing != NONE) {
+      return existing;
+    }
+    index_type const created = create_node();
+    m_link(node, label, created);
+    return created;
+  }
+
+  /**
+   * @brief Unlink the child of `node` along `label`, which must exist. The child
+   * itself is left alone; a node left far below its capacity is shrunk to a
+   * smaller representation.
+   *
+   * @param node The parent node
+   * @param label The edge label
+   */
+  void remove_child(index_type node, std::uint8_t label) {
+    Node &n = m_nodes[node];
+    switch (n.kind) {
+    case ONE:
+      n.kind = EMPTY;
+      n.slot = NONE;
+      break;
+    case FOUR:
+      m_erase_sorted(m_four.items[n.slot], n.count, label);
+      break;
+    case SIXTEEN:
+      m_erase_sorted(m_sixteen.items[n.slot], n.count, label);
+      break;
+    case FORTY_EIGHT: {
+      // Keep `children` dense: move the last child into the vacated position
+      auto &s = m_forty_eight.items[n.slot];
+      std::uint8_t const pos = s.index[label];
+      s.index[label] = 0;
+      if (pos != n.count) {
+        s.children[pos - 1] = s.children[n.count - 1];
+        for (std::size_t c = 0; c < 256; ++c) {
+          if (s.index[c] == n.count) {
+            s.index[c] = pos;
+            break;
+          }
+        }
+      }
+      break;
+    }
+    default:
+      m_full.items[n.slot].children[label] = NONE;
+      break;
+    }
+    --n.count;
+
+    // Shrink with some slack below the smaller capacity, so that a node hovering
+    // at a boundary does not convert back and forth on every update
+    bool const sparse = (n.kind == FOUR && n.count <= 1) ||
+                        (n.kind == SIXTEEN && n.count <= 3) ||
+                        (n.kind == FORTY_EIGHT && n.count <= 12) ||
+                        (n.kind == FULL && n.count <= 40);
+    if (sparse) {
+      m_shrink(node);
+    }
+  }
+
+  /**
+   * @brief Return a node to the pool for reuse by create_node(). It must have no
+   * children and no longer be linked from a parent; it must not be the root.
+   *
+   * @param node The node to free
+   */
+  void free_node(index_type node) {
+    m_nodes[node] = Node{};
+    m_free_nodes.push_back(node);
+  }
+
+  /**
+   * @brief Follow `bytes` from `node`
+   *
+   * @param node The node to start from
+   * @param first Iterator to the first label
+   * @param last End of the labels
+   * @return index_type The node reached, or NONE if the path leaves the trie
+   */
+  template <typename It>
+  [[nodiscard]] index_type walk(index_type node, It first, It last) const noexcept {
+    for (; first != last && node != NONE; ++first) {
+      node = child(node, static_cast<std::uint8_t>(*first));
+    }
+    return node;
+  }
+
+  /**
+   * @brief Check if a word ends at `node`
+   */
+  [[nodiscard]] bool terminal(index_type node) const noexcept {
+    return m_nodes[node].terminal;
+  }
+
+  /**
+   * @brief Mark or unmark `node` as the end of a word
+   */
+  void set_terminal(index_type node, bool value) noexcept {
+    m_nodes[node].terminal = value;
+  }
+
+  /**
+   * @brief Get the number of children of `node`
+   */
+  [[nodiscard]] std::size_t child_count(index_type node) const noexcept {
+    return m_nodes[node].count;
+  }
+
+  /**
+   * @brief Visit the children of `node` in ascending label order
+   *
+   * @param node The parent node
+   * @param f Called as f(label, child)
+   */
+  template <typename F>
+  void for_each_child(index_type node, F &&f) const {
+    Node const &n = m_nodes[node];
+    switch (n.kind) {
+    case EMPTY:
+      break;
+    case ONE:
+      f(n.label, n.slot);
+      break;
+    case FOUR: {
+      auto const &s = m_four.items[n.slot];
+      for (std::size_t i = 0; i < n.count; ++i) {
+        f(s.labels[i], s.children[i]);
+      }
+      break;
+    }
+    case SIXTEEN: {
+      auto const &s = m_sixteen.items[n.slot];
+      for (std::size_t i = 0; i < n.count; ++i) {
+        f(s.labels[i], s.children[i]);
+      }
+      break;
+    }
+    case FORTY_EIGHT: {
+      auto const &s = m_forty_eight.items[n.slot];
+      for (std::size_t c = 0; c < 256; ++c) {
+        if (s.index[c]) {
+          f(static_cast<std::uint8_t>(c), s.children[s.index[c] - 1]);
+        }
+      }
+      break;
+    }
+    default: {
+      auto const &s = m_full.items[n.slot];
+      for (std::size_t c = 0; c < 256; ++c) {
+        if (s.children[c] != NONE) {
+          f(static_cast<std::uint8_t>(c), s.children[c]);
+        }
+      }
+      break;
+    }
+    }
+  }
+
+  /**
+   * @brief Get the number of nodes, including the root
+   */
+  [[nodiscard]] std::size_t node_count() const noexcept {
+    return m_nodes.size() - m_free_nodes.size();
+  }
+
+  /**
+   * @brief Get one past the largest node index in use, for sizing arrays indexed
+   * by node; equal to node_count() unless nodes have been freed
+   */
+  [[nodiscard]] std::size_t index_bound() const noexcept { return m_nodes.size(); }
+
+  /**
+   * @brief Get the number of bytes reserved for nodes and child arrays
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_nodes.capacity() * sizeof(Node) +
+           m_free_nodes.capacity() * sizeof(index_type) + m_four.memory_usage() +
+           m_sixteen.memory_usage() + m_forty_eight.memory_usage() +
+           m_full.memory_usage();
+  }
+
+  /**
+   * @brief Drop every node but a fresh root
+   */
+  void clear() noexcept {
+    m_nodes.resize(1);
+    m_nodes[ROOT] = Node{};
+    m_free_nodes.clear();
+    m_four.clear();
+    m_sixteen.clear();
+    m_forty_eight.clear();
+    m_full.clear();
+  }
+};
+
+} // namespace ming
+
+#endif // MING_TRIE_NODE_POOL
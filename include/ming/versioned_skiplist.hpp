@@ -0,0 +1,320 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#ifndef MING_VERSIONED_SKIPLIST
+#define MING_VERSIONED_SKIPLIST
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include <ming/concurrent_skiplist.hpp>
+
+namespace ming {
+
+/**
+ * @brief A multi-version ordered map in the style of an LSM memtable. Every write
+ * appends a new version tagged with a sequence number instead of overwriting, so
+ * a snapshot is just a sequence number: its reads see exactly the writes that were
+ * published before it was taken, without copying the map or blocking writers.
+ *
+ * Versions live in a ConcurrentSkipListMap ordered by (key ascending, sequence
+ * descending), so the newest version visible to a snapshot is the first entry at
+ * or after (key, snapshot sequence). Old versions are never dropped; like a
+ * memtable, the whole map is meant to be flushed and discarded.
+ *
+ * @see https://github.com/facebook/rocksdb/wiki/MemTable
+ *
+ * @tparam Key The key type used for comparison and ordering
+ * @tparam T The value type; values are immutable once written
+ * @tparam Compare The comparison function type
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class VersionedSkipList {
+private:
+  struct InternalKey {
+    Key key;
+    std::uint64_t sequence;
+  };
+
+  struct InternalCompare {
+    [[no_unique_address]] Compare compare;
+
+    bool operator()(InternalKey const &a, InternalKey const &b) const {
+      if (compare(a.key, b.key)) {
+        return true;
+      }
+      if (compare(b.key, a.key)) {
+        return false;
+      }
+      // newer versions of a key come first
+      return a.sequence > b.sequence;
+    }
+  };
+
+  // std::nullopt is a tombstone left by erase()
+  using Entry = std::optional<T>;
+
+  using map_type = ConcurrentSkipListMap<InternalKey, Entry, InternalCompare>;
+
+  map_type m_versions;
+
+  Compare m_compare;
+
+  // Serializes writers so that sequence numbers are published in order
+  std::mutex m_write_mutex;
+
+  // Highest sequence number whose write is fully linked in
+  std::atomic<std::uint64_t> m_published{0};
+
+  template <typename K>
+  std::uint64_t m_write(K &&key, Entry &&entry) {
+    std::lock_guard lock(m_write_mutex);
+    std::uint64_t const sequence = m_published.load(std::memory_order_relaxed) + 1;
+    m_versions.insert(InternalKey{std::forward<K>(key), sequence}, std::move(entry));
+    m_published.store(sequence, std::memory_order_release);
+    return sequence;
+  }
+
+public:
+  class Snapshot;
+
+  /**
+   * @brief Forward iterator over the keys visible to a snapshot, in key order,
+   * yielding the newest visible value of each. Like the underlying map's
+   * iterator, it keeps the creating thread pinned while it lives.
+   */
+  class iterator {
+  private:
+    friend class Snapshot;
+
+    typename map_type::iterator m_it;
+    typename map_type::iterator m_end;
+    std::uint64_t m_sequence;
+    Compare const *m_compare;
+
+    iterator(typename map_type::iterator it, typename map_type::iterator end,
+             std::uint64_t sequence, Compare const *compare)
+        : m_it(std::move(it)), m_end(std::move(end)), m_sequence(sequence),
+          m_compare(compare) {
+      settle();
+    }
+
+    // Step past every remaining version of the current key
+    void skip_key() {
+      Key const &key = (*m_it).first.key;
+      do {
+        ++m_it;
+      } while (m_it != m_end && !(*m_compare)(key, (*m_it).first.key));
+    }
+
+    // Stop at the newest visible version of a key that is not a tombstone
+    void settle() {
+      while (m_it != m_end) {
+        auto [ikey, entry] = *m_it;
+        if (ikey.sequence > m_sequence) {
+          ++m_it;
+        } else if (!entry) {
+          skip_key();
+        } else {
+          return;
+        }
+      }
+    }
+
+  public:
+    using value_type = std::pair<const Key &, const T &>;
+    using reference = value_type;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    iterator &operator++() {
+      skip_key();
+      settle();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(iterator const &other) const noexcept { return m_it == other.m_it; }
+
+    bool operator!=(iterator const &other) const noexcept { return !(*this == other); }
+
+    value_type operator*() const noexcept {
+      auto [ikey, entry] = *m_it;
+      return {ikey.key, *entry};
+    }
+  };
+
+  /**
+   * @brief A consistent, read-only view of the map as of one sequence number.
+   * Taking one is O(1) and it stays valid for as long as the map does.
+   */
+  class Snapshot {
+  private:
+    friend class VersionedSkipList;
+
+    VersionedSkipList const *m_owner;
+    std::uint64_t m_sequence;
+
+    Snapshot(VersionedSkipList const *owner, std::uint64_t sequence) noexcept
+        : m_owner(owner), m_sequence(sequence) {}
+
+  public:
+    /**
+     * @brief Get the sequence number of the last write this snapshot sees
+     */
+    [[nodiscard]] std::uint64_t sequence() const noexcept { return m_sequence; }
+
+    /**
+     * @brief Find the value of `key` as of this snapshot
+     *
+     * @param key The key to search for
+     * @return std::optional<T> The value, or std::nullopt if the key was absent
+     */
+    [[nodiscard]] std::optional<T> find(Key const &key) const {
+      auto it = m_owner->m_versions.lower_bound(InternalKey{key, m_sequence});
+      if (it == m_owner->m_versions.end()) {
+        return std::nullopt;
+      }
+      auto [ikey, entry] = *it;
+      if (m_owner->m_compare(key, ikey.key)) {
+        return std::nullopt;
+      }
+      return entry;
+    }
+
+    /**
+     * @brief Check if `key` was present as of this snapshot
+     */
+    [[nodiscard]] bool contains(Key const &key) const { return find(key).has_value(); }
+
+    /**
+     * @brief Get an iterator to the first key visible to this snapshot
+     */
+    iterator begin() const {
+      return iterator(m_owner->m_versions.begin(), m_owner->m_versions.end(),
+                      m_sequence, &m_owner->m_compare);
+    }
+
+    /**
+     * @brief Get an iterator to the end
+     */
+    iterator end() const {
+      return iterator(m_owner->m_versions.end(), m_owner->m_versions.end(), m_sequence,
+                      &m_owner->m_compare);
+    }
+
+    /**
+     * @brief Get an iterator to the first visible key not less than `key`
+     */
+    iterator lower_bound(Key const &key) const {
+      return iterator(m_owner->m_versions.lower_bound(InternalKey{key, m_sequence}),
+                      m_owner->m_versions.end(), m_sequence, &m_owner->m_compare);
+    }
+  };
+
+  /**
+   * @brief Construct a new, empty VersionedSkipList
+   */
+  VersionedSkipList() : VersionedSkipList(Compare{}) {}
+
+  /**
+   * @brief Construct a new VersionedSkipList with custom comparator
+   *
+   * @param comp The comparison function object
+   */
+  explicit VersionedSkipList(Compare comp)
+      : m_versions(InternalCompare{comp}), m_compare(std::move(comp)) {}
+
+  VersionedSkipList(VersionedSkipList const &) = delete;
+  VersionedSkipList &operator=(VersionedSkipList const &) = delete;
+
+  /**
+   * @brief Write a new version of `key`
+   *
+   * @param key The key to write
+   * @param value The value to write
+   * @return std::uint64_t The sequence number of the write
+   */
+  std::uint64_t put(Key key, T value) {
+    return m_write(std::move(key), Entry(std::move(value)));
+  }
+
+  /**
+   * @brief Delete `key` by writing a tombstone; older snapshots still see it
+   *
+   * @param key The key to delete
+   * @return std::uint64_t The sequence number of the write
+   */
+  std::uint64_t erase(Key key) { return m_write(std::move(key), Entry(std::nullopt)); }
+
+  /**
+   * @brief Take a snapshot of every write published so far
+   */
+  [[nodiscard]] Snapshot snapshot() const noexcept {
+    return Snapshot(this, m_published.load(std::memory_order_acquire));
+  }
+
+  /**
+   * @brief Take a snapshot as of an earlier sequence number
+   *
+   * @param sequence A sequence number returned by put() or erase()
+   */
+  [[nodiscard]] Snapshot snapshot(std::uint64_t sequence) const noexcept {
+    return Snapshot(this,
+                    std::min(sequence, m_published.load(std::memory_order_acquire)));
+  }
+
+  /**
+   * @brief Find the latest value of `key`
+   *
+   * @param key The key to search for
+   * @return std::optional<T> The value, or std::nullopt if the key is absent
+   */
+  [[nodiscard]] std::optional<T> find(Key const &key) const {
+    return snapshot().find(key);
+  }
+
+  /**
+   * @brief Get the sequence number of the latest published write
+   */
+  [[nodiscard]] std::uint64_t sequence() const noexcept {
+    return m_published.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Get the number of stored versions, including tombstones
+   */
+  [[nodiscard]] std::size_t versions() const noexcept { return m_versions.size(); }
+};
+
+} // namespace ming
+
+#endif // MING_VERSIONED_SKIPLIST
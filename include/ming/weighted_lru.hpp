@@ -19,66 +19,642 @@
 #ifndef MING_WEIGHTED_LRU
 #define MING_WEIGHTED_LRU
 
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <expected>
-#include <iostream>
-#include <list>
+#include <functional>
+#include <limits>
+#include <optional>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <ming/eviction_policy.hpp>
 
 namespace ming {
 
-template <typename K, typename V>
+namespace detail {
+
+/**
+ * @brief How WeightedLRU takes keys to look up: strings as string views, which
+ * hash and compare like the strings, and anything else by reference
+ */
+template <typename K>
+struct LookupKey {
+  using type = K const &;
+};
+
+template <typename C, typename T, typename A>
+struct LookupKey<std::basic_string<C, T, A>> {
+  using type = std::basic_string_view<C, T>;
+};
+
+} // namespace detail
+
+/**
+ * @brief A cache bounded by the total weight of its entries rather than their
+ * number, evicting least recently used entries first unless given another policy
+ *
+ * Entries live in a slab, a vector whose slots are recycled through a free list.
+ * Keys are found through an open-addressing hash table of slot indices with
+ * linear probing, and the eviction policy orders the slots in arrays of its own.
+ * Once the cache has reached its working size, get() and put() allocate nothing of
+ * their own under LRUPolicy, SLRUPolicy or GDSFPolicy: a put that evicts reuses
+ * the slot it freed, and the table only grows with the number of live entries.
+ *
+ * Entries may be given a time to live. An expired entry is a miss, and get()
+ * reclaims its weight on the spot; the others are found by a hierarchical timing
+ * wheel that every put() advances, so expiration needs neither a background
+ * thread nor a scan of the cache. Until then they still count towards size() and
+ * weight(). The timers live in arrays that are only allocated once a TTL is used.
+ *
+ * String keys are looked up as string views, so a std::string_view or a literal
+ * finds a std::string key without building a temporary string.
+ *
+ * @tparam K The key type; hashed with std::hash<K>
+ * @tparam V The value type
+ * @tparam Policy Decides which entry to evict; see EvictionPolicy
+ * @tparam Clock Tells the time for TTLs; replaceable in tests
+ */
+template <typename K, typename V, EvictionPolicy Policy = LRUPolicy,
+          typename Clock = std::chrono::steady_clock>
+  requires std::chrono::is_clock_v<Clock>
 class WeightedLRU {
+public:
+  /** @brief The key type lookups take: a string view for string keys, else K */
+  using key_view = typename detail::LookupKey<K>::type;
+
+  /** @brief A cached entry */
   struct LRUItem {
     K key;
     V value;
     int size;
   };
 
+private:
+  using index_type = std::uint32_t;
+
+  static constexpr index_type NONE = std::numeric_limits<index_type>::max();
+  static constexpr std::uint64_t EMPTY = std::numeric_limits<std::uint64_t>::max();
+  static constexpr std::size_t NOT_FOUND = std::numeric_limits<std::size_t>::max();
+
+  using time_point = typename Clock::time_point;
+
+  static constexpr time_point NEVER = time_point::max();
+  /** @brief A wheel tick is 2^20 ns, about a millisecond */
+  static constexpr int TICK_BITS = 20;
+  /** @brief Each level has 64 slots, each spanning 64 slots of the level below */
+  static constexpr int SLOT_BITS = 6;
+  static constexpr std::size_t WHEEL_SLOTS = std::size_t{1} << SLOT_BITS;
+  /** @brief Five levels reach 2^50 ns, 13 days; later expiries wait at the top */
+  static constexpr int WHEEL_LEVELS = 5;
+  static constexpr std::uint16_t UNSCHEDULED =
+      std::numeric_limits<std::uint16_t>::max();
+
+  /**
+   * @brief A slab slot. A free slot links to the next free one through `next`.
+   */
+  struct Entry {
+    std::optional<LRUItem> item;
+    index_type next{NONE};
+    // The upper half of the key's hash, kept so the index can be updated on
+    // eviction without hashing the key again
+    std::uint32_t tag{0};
+  };
+
+  /**
+   * @brief The expiry of the entry in the same slab slot, which is linked into
+   * wheel slot `slot` among the entries expiring around the same time
+   */
+  struct Timer {
+    time_point expiry{NEVER};
+    index_type prev{NONE};
+    index_type next{NONE};
+    std::uint16_t slot{UNSCHEDULED};
+  };
+
   int m_capacity, m_current_cap;
-  std::list<LRUItem> m_store;
-  std::unordered_map<K, typename std::list<LRUItem>::iterator> m_cache_positions;
+  std::vector<Entry> m_entries;
+  Policy m_policy;
+  index_type m_free{NONE};
+  std::size_t m_size{0};
+  // The index: each slot is EMPTY or (tag << 32 | entry). A power-of-two table
+  // whose home slot for a tag is its top m_bits bits, so growing it never needs
+  // to hash a key.
+  std::vector<std::uint64_t> m_slots;
+  int m_bits{0};
+  // The wheel is empty until the first put() with a TTL; from then on there is a
+  // timer for every slab slot
+  std::vector<Timer> m_timers;
+  std::vector<index_type> m_wheel;
+  std::uint64_t m_wheel_tick{0};
+  std::size_t m_scheduled{0};
+
+  static std::uint32_t m_tag(key_view key) {
+    // Fibonacci hashing spreads identity hashes such as std::hash<int>. The hash of
+    // a string view equals that of the string.
+    auto const h =
+        static_cast<std::uint64_t>(std::hash<std::remove_cvref_t<key_view>>{}(key));
+    return static_cast<std::uint32_t>((h * 0x9e3779b97f4a7c15ULL) >> 32);
+  }
+
+  static std::size_t m_home(std::uint32_t tag, int bits) noexcept {
+    return static_cast<std::size_t>(tag >> (32 - bits));
+  }
+
+  std::size_t m_home(std::uint32_t tag) const noexcept { return m_home(tag, m_bits); }
+
+  /**
+   * @brief Find the index slot holding `key`, or NOT_FOUND
+   */
+  std::size_t m_lookup(key_view key, std::uint32_t tag) const {
+    if (m_slots.empty()) {
+      return NOT_FOUND;
+    }
+    std::size_t const mask = m_slots.size() - 1;
+    for (std::size_t i = m_home(tag);; i = (i + 1) & mask) {
+      std::uint64_t const slot = m_slots[i];
+      if (slot == EMPTY) {
+        return NOT_FOUND;
+      }
+      if ((slot >> 32) == tag &&
+          m_entries[static_cast<index_type>(slot)].item->key == key) {
+        return i;
+      }
+    }
+  }
+
+  static void m_place(std::vector<std::uint64_t> &slots, int bits,
+                      std::uint64_t slot) noexcept {
+    std::size_t const mask = slots.size() - 1;
+    std::size_t i = m_home(static_cast<std::uint32_t>(slot >> 32), bits);
+    while (slots[i] != EMPTY) {
+      i = (i + 1) & mask;
+    }
+    slots[i] = slot;
+  }
+
+  /**
+   * @brief Make room in the index for one more entry, keeping the load factor at
+   * most 3/4. The grown table is filled before it replaces the current one, so a
+   * failed allocation leaves the index as it was.
+   */
+  void m_reserve_index() {
+    if ((m_size + 1) * 4 <= m_slots.size() * 3) {
+      return;
+    }
+    std::size_t const size = std::max<std::size_t>(16, m_slots.size() * 2);
+    int const bits = std::countr_zero(size);
+    std::vector<std::uint64_t> grown(size, EMPTY);
+    for (std::uint64_t slot : m_slots) {
+      if (slot != EMPTY) {
+        m_place(grown, bits, slot);
+      }
+    }
+    m_slots = std::move(grown);
+    m_bits = bits;
+  }
+
+  /**
+   * @brief Empty index slot `i`, shifting later slots of the same probe run back
+   * so that no tombstone is left behind
+   */
+  void m_unindex(std::size_t i) noexcept {
+    std::size_t const mask = m_slots.size() - 1;
+    for (std::size_t j = (i + 1) & mask; m_slots[j] != EMPTY; j = (j + 1) & mask) {
+      std::size_t const home = m_home(static_cast<std::uint32_t>(m_slots[j] >> 32));
+      // The slot at j may fill the hole unless its home lies in (i, j]
+      if (((j - home) & mask) >= ((j - i) & mask)) {
+        m_slots[i] = m_slots[j];
+        i = j;
+      }
+    }
+    m_slots[i] = EMPTY;
+  }
+
+  /**
+   * @brief Take a slot from the free list, or append one to the slab (and to the
+   * timers, once there are any). If appending fails, neither array grows.
+   */
+  index_type m_acquire() {
+    if (m_free != NONE) {
+      return std::exchange(m_free, m_entries[m_free].next);
+    }
+    if (m_entries.size() == NONE) {
+      throw std::length_error("WeightedLRU has too many entries!");
+    }
+    m_entries.emplace_back();
+    if (!m_wheel.empty()) {
+      try {
+        m_timers.emplace_back();
+      } catch (...) {
+        m_entries.pop_back();
+        throw;
+      }
+    }
+    return static_cast<index_type>(m_entries.size() - 1);
+  }
+
+  /**
+   * @brief Return an empty slot taken by m_acquire() to the free list
+   */
+  void m_release(index_type e) noexcept {
+    m_entries[e].next = m_free;
+    m_free = e;
+  }
+
+  static std::uint64_t m_tick(time_point t) {
+    auto const ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch());
+    return ns.count() < 0 ? 0 : static_cast<std::uint64_t>(ns.count()) >> TICK_BITS;
+  }
+
+  bool m_expired(index_type e) const {
+    return !m_wheel.empty() && m_timers[e].expiry != NEVER &&
+           m_timers[e].expiry <= Clock::now();
+  }
+
+  /**
+   * @brief Link entry `e` into the wheel slot of its expiry: on the lowest level
+   * whose slots, counted from now, reach it
+   */
+  void m_schedule(index_type e) noexcept {
+    Timer &timer = m_timers[e];
+    // An entry that is already due waits for the next tick
+    std::uint64_t const tick = std::max(m_tick(timer.expiry), m_wheel_tick + 1);
+    std::uint64_t const delta = tick - m_wheel_tick;
+    int level = 0;
+    while (level + 1 < WHEEL_LEVELS && (delta >> (SLOT_BITS * (level + 1))) != 0) {
+      ++level;
+    }
+    auto const slot = static_cast<std::uint16_t>(
+        static_cast<std::size_t>(level) * WHEEL_SLOTS +
+        ((tick >> (SLOT_BITS * level)) & (WHEEL_SLOTS - 1)));
+    timer.slot = slot;
+    timer.prev = NONE;
+    timer.next = m_wheel[slot];
+    if (timer.next != NONE) {
+      m_timers[timer.next].prev = e;
+    }
+    m_wheel[slot] = e;
+    ++m_scheduled;
+  }
+
+  void m_unschedule(index_type e) noexcept {
+    Timer &timer = m_timers[e];
+    if (timer.slot == UNSCHEDULED) {
+      return;
+    }
+    (timer.prev == NONE ? m_wheel[timer.slot] : m_timers[timer.prev].next) =
+        timer.next;
+    if (timer.next != NONE) {
+      m_timers[timer.next].prev = timer.prev;
+    }
+    timer.slot = UNSCHEDULED;
+    --m_scheduled;
+  }
+
+  /**
+   * @brief Allocate the timers and the wheel, if this is the first expiry
+   */
+  void m_enable_timers() {
+    if (!m_wheel.empty()) {
+      return;
+    }
+    std::vector<index_type> wheel(WHEEL_LEVELS * WHEEL_SLOTS, NONE);
+    m_timers.resize(m_entries.size());
+    m_wheel = std::move(wheel);
+  }
+
+  /**
+   * @brief Set when entry `e` expires; NEVER takes it out of the wheel. The timers
+   * must have been enabled unless `expiry` is NEVER.
+   */
+  void m_expire_at(index_type e, time_point expiry) noexcept {
+    if (m_wheel.empty()) {
+      return;
+    }
+    m_unschedule(e);
+    m_timers[e].expiry = expiry;
+    if (expiry != NEVER) {
+      m_schedule(e);
+    }
+  }
+
+  /**
+   * @brief Turn the wheel to `now`, visiting at most every slot once per level:
+   * due entries are removed, the others move down to the slot of their expiry
+   */
+  void m_advance(time_point now) {
+    std::uint64_t const tick = m_tick(now);
+    if (tick <= m_wheel_tick) {
+      return;
+    }
+    std::uint64_t const previous = std::exchange(m_wheel_tick, tick);
+    if (m_scheduled == 0) {
+      return;
+    }
+    for (int level = 0; level < WHEEL_LEVELS; ++level) {
+      std::uint64_t const from = previous >> (SLOT_BITS * level);
+      std::uint64_t const to = tick >> (SLOT_BITS * level);
+      if (from == to) {
+        // Nor have the slots of any higher level passed
+        break;
+      }
+      std::uint64_t const steps = std::min<std::uint64_t>(to - from, WHEEL_SLOTS);
+      for (std::uint64_t step = 1; step <= steps; ++step) {
+        std::size_t const slot = static_cast<std::size_t>(level) * WHEEL_SLOTS +
+                                 ((from + step) & (WHEEL_SLOTS - 1));
+        index_type e = std::exchange(m_wheel[slot], NONE);
+        while (e != NONE) {
+          Timer &timer = m_timers[e];
+          index_type const next = timer.next;
+          timer.slot = UNSCHEDULED;
+          --m_scheduled;
+          if (timer.expiry <= now) {
+            m_remove(e, false);
+          } else {
+            m_schedule(e);
+          }
+          e = next;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Unindex entry `e`, free its slot and hand back its item
+   */
+  LRUItem m_remove(index_type e, bool evicted) {
+    // First, as it is the only step that may throw (remembering an evicted key)
+    m_policy.erase(e, evicted);
+    Entry &entry = m_entries[e];
+    std::uint64_t const slot = std::uint64_t{entry.tag} << 32 | e;
+    std::size_t i = m_home(entry.tag);
+    while (m_slots[i] != slot) {
+      i = (i + 1) & (m_slots.size() - 1);
+    }
+    m_unindex(i);
+    if (!m_wheel.empty()) {
+      m_unschedule(e);
+      m_timers[e].expiry = NEVER;
+    }
+
+    LRUItem item = std::move(*entry.item);
+    m_current_cap -= item.size;
+    entry.item.reset();
+    entry.next = m_free;
+    m_free = e;
+    --m_size;
+    return item;
+  }
+
+  /**
+   * @brief Drop the entry the policy picks
+   */
+  void m_evict() { m_remove(m_policy.victim(), true); }
+
+  void m_put(K key, V value, int size, time_point expiry) {
+    std::uint32_t const tag = m_tag(key);
+    std::size_t const slot = m_lookup(key, tag);
+    if (expiry != NEVER) {
+      m_enable_timers();
+    }
+    if (slot != NOT_FOUND) {
+      auto const e = static_cast<index_type>(m_slots[slot]);
+      LRUItem &item = *m_entries[e].item;
+      item.value = std::move(value);
+      m_current_cap += size - item.size;
+      item.size = size;
+      m_policy.access(e);
+      m_policy.resize(e, size);
+      m_expire_at(e, expiry);
+      while (m_current_cap > m_capacity) {
+        m_evict();
+      }
+      return;
+    }
+
+    while (m_current_cap + size > m_capacity) {
+      m_evict();
+    }
+    // Everything that allocates comes before the entry is counted or indexed, and
+    // is undone if a later step throws
+    m_reserve_index();
+    index_type const e = m_acquire();
+    bool inserted = false;
+    try {
+      m_policy.insert(e, tag, size);
+      inserted = true;
+      m_entries[e].item.emplace(LRUItem{std::move(key), std::move(value), size});
+    } catch (...) {
+      if (inserted) {
+        m_policy.erase(e, false);
+      }
+      m_release(e);
+      throw;
+    }
+    m_entries[e].tag = tag;
+    m_place(m_slots, m_bits, std::uint64_t{tag} << 32 | e);
+    ++m_size;
+    m_current_cap += size;
+    m_expire_at(e, expiry);
+  }
 
 public:
-  explicit WeightedLRU(int capacity) : m_capacity{capacity}, m_current_cap{} {}
+  /** @brief Identifies a cached entry; valid until the next put() */
+  using handle_type = index_type;
 
-  std::expected<V, std::string> get(K const &key) {
-    auto it = m_cache_positions.find(key);
-    if (it == m_cache_positions.end()) {
-      return std::unexpected{"No such key!"};
+  /** @brief The handle find() returns for a key that is not cached */
+  static constexpr handle_type NOT_CACHED = NONE;
+
+  /**
+   * @brief Construct an empty cache
+   *
+   * @param capacity The largest total weight the cache may hold
+   */
+  explicit WeightedLRU(int capacity)
+      : m_capacity{capacity}, m_current_cap{}, m_policy(capacity) {}
+
+  /**
+   * @brief Look up a key and record the access with the policy
+   *
+   * @param key The key to look up
+   * @return std::expected<V, std::string> A copy of the value, or an error if the
+   * key is not cached
+   */
+  std::expected<V, std::string> get(key_view key) {
+    if (V const *value = get_if(key)) {
+      return *value;
+    }
+    return std::unexpected{"No such key!"};
+  }
+
+  /**
+   * @brief Look up a key and record the access with the policy, without copying
+   * the value. To hold on to a value beyond the next put(), cache it as a
+   * std::shared_ptr<V const> and copy that.
+   *
+   * @param key The key to look up
+   * @return V const* The cached value, valid until its entry is removed or the next
+   * put(); or nullptr if the key is not cached
+   */
+  [[nodiscard]] V const *get_if(key_view key) {
+    std::size_t const slot = m_lookup(key, m_tag(key));
+    if (slot == NOT_FOUND) {
+      return nullptr;
+    }
+    auto const e = static_cast<index_type>(m_slots[slot]);
+    if (m_expired(e)) {
+      m_remove(e, false);
+      return nullptr;
+    }
+    touch(e);
+    return &m_entries[e].item->value;
+  }
+
+  /**
+   * @brief Look up a key without recording the access, so that concurrent readers
+   * may share the cache; see touch()
+   *
+   * @param key The key to look up
+   * @return handle_type The entry's handle, or NOT_CACHED, also if it has expired
+   */
+  [[nodiscard]] handle_type find(key_view key) const {
+    std::size_t const slot = m_lookup(key, m_tag(key));
+    if (slot == NOT_FOUND) {
+      return NOT_CACHED;
     }
+    auto const e = static_cast<handle_type>(m_slots[slot]);
+    return m_expired(e) ? NOT_CACHED : e;
+  }
 
-    m_store.splice(m_store.begin(), m_store, it->second);
-    it->second = m_store.begin();
-    return it->second->value;
+  /**
+   * @brief Get the value of the entry found by find()
+   */
+  [[nodiscard]] V const &value(handle_type e) const noexcept {
+    return m_entries[e].item->value;
   }
 
+  /**
+   * @brief Record an access to the entry found by find(), e.g. under LRU make it
+   * the most recently used
+   */
+  void touch(handle_type e) noexcept { m_policy.access(e); }
+
+  /**
+   * @brief Insert or update an entry that never expires, evicting the entries the
+   * policy picks until the total weight fits. Under LRU an update is never evicted
+   * by its own put(). If an allocation throws, the cache holds what it held before,
+   * less any entries already evicted.
+   *
+   * @param key The key
+   * @param value The value
+   * @param size The entry's weight
+   * @throws std::runtime_error If `size` exceeds the capacity
+   */
   void put(K key, V value, int size) {
     if (size > m_capacity) {
       throw std::runtime_error("Sorry this is too big!");
     }
+    if (m_scheduled != 0) {
+      m_advance(Clock::now());
+    }
+    m_put(std::move(key), std::move(value), size, NEVER);
+  }
 
-    auto it = m_cache_positions.find(key);
-    if (it != m_cache_positions.end()) {
-      m_current_cap -= it->second->size;
-      m_store.erase(it->second);
-      m_cache_positions.erase(it);
+  /**
+   * @brief Insert or update an entry that expires after `ttl`, first dropping the
+   * entries that have expired, then evicting as put(key, value, size) does
+   *
+   * @param key The key
+   * @param value The value
+   * @param size The entry's weight
+   * @param ttl How long the entry lives
+   * @throws std::runtime_error If `size` exceeds the capacity
+   */
+  void put(K key, V value, int size, typename Clock::duration ttl) {
+    if (size > m_capacity) {
+      throw std::runtime_error("Sorry this is too big!");
     }
+    time_point const now = Clock::now();
+    m_advance(now);
+    // A TTL too long to represent never expires
+    time_point const expiry = ttl < NEVER - now ? now + ttl : NEVER;
+    m_put(std::move(key), std::move(value), size, expiry);
+  }
 
-    while (m_current_cap + size > m_capacity) {
-      auto const &last = m_store.back();
-      m_cache_positions.erase(last.key);
-      m_current_cap -= last.size;
-      m_store.pop_back();
+  /**
+   * @brief Drop the entries that have expired, to within a wheel tick (about a
+   * millisecond); put() does this too
+   */
+  void expire() {
+    if (m_scheduled != 0) {
+      m_advance(Clock::now());
     }
+  }
 
-    m_store.push_front({std::move(key), std::move(value), size});
-    m_cache_positions[m_store.front().key] = m_store.begin();
-    m_current_cap += size;
+  /**
+   * @brief Get the entry the policy would evict next, e.g. under LRU the least
+   * recently used
+   *
+   * @return handle_type Its handle, or NOT_CACHED if the cache is empty
+   */
+  [[nodiscard]] handle_type victim() noexcept { return m_policy.victim(); }
+
+  /**
+   * @brief Get the key, value and weight of an entry
+   */
+  [[nodiscard]] LRUItem const &item(handle_type e) const noexcept {
+    return *m_entries[e].item;
+  }
+
+  /**
+   * @brief Remove an entry and hand it back, e.g. to move it to another cache
+   *
+   * @param e The handle of a cached entry
+   * @return LRUItem The removed entry
+   */
+  LRUItem extract(handle_type e) { return m_remove(e, false); }
+
+  /**
+   * @brief Get the number of cached entries
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+  /**
+   * @brief Check if the cache is empty
+   */
+  [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+  /**
+   * @brief Get the total weight of the cached entries
+   */
+  [[nodiscard]] int weight() const noexcept { return m_current_cap; }
+
+  /**
+   * @brief Get the largest total weight the cache may hold
+   */
+  [[nodiscard]] int capacity() const noexcept { return m_capacity; }
+
+  /**
+   * @brief Get the number of bytes reserved for entries, the index, the policy and
+   * the timers, excluding memory that keys and values own
+   */
+  [[nodiscard]] std::size_t memory_usage() const noexcept {
+    return m_entries.capacity() * sizeof(Entry) +
+           m_slots.capacity() * sizeof(std::uint64_t) + m_policy.memory_usage() +
+           m_timers.capacity() * sizeof(Timer) +
+           m_wheel.capacity() * sizeof(index_type);
   }
 };
 
 } // namespace ming
 
-#endif // MING_WEIGHTED_LRU
\ No newline at end of file
+#endif // MING_WEIGHTED_LRU
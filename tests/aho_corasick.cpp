@@ -0,0 +1,104 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <ming/aho_corasick.hpp>
+#include <ming/trie.hpp>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace aho_corasick_test {
+
+using Matches = std::vector<std::pair<std::size_t, std::size_t>>;
+
+static Matches all_matches(ming::AhoCorasick const &ac, std::string_view text) {
+  Matches found;
+  ac.scan(text,
+          [&](std::size_t pos, std::size_t len) { found.emplace_back(pos, len); });
+  return found;
+}
+
+TEST(AhoCorasick_TEST, ClassicExample) {
+  ming::Trie<char> trie{"he", "she", "his", "hers"};
+  auto const ac = trie.compile();
+  // "ushers": she@1, he@2, hers@2; ends at 4, 4, 6
+  EXPECT_EQ(all_matches(ac, "ushers"), (Matches{{1, 3}, {2, 2}, {2, 4}}));
+  EXPECT_EQ(ac.count("ahishers"), 4u);
+  EXPECT_EQ(ac.count("xyz"), 0u);
+  EXPECT_EQ(ac.count(""), 0u);
+  EXPECT_EQ(ac.state_count(), trie.node_count());
+}
+
+TEST(AhoCorasick_TEST, OverlappingAndNested) {
+  ming::Trie<char> trie{"a", "aa", "aaa"};
+  auto const ac = trie.compile();
+  EXPECT_EQ(all_matches(ac, "aaa"),
+            (Matches{{0, 1}, {0, 2}, {1, 1}, {0, 3}, {1, 2}, {2, 1}}));
+}
+
+TEST(AhoCorasick_TEST, StreamAcrossChunks) {
+  ming::Trie<char> trie{"needle", "need"};
+  auto const ac = trie.compile();
+  auto stream = ac.stream();
+  Matches found;
+  auto record = [&](std::size_t pos, std::size_t len) { found.emplace_back(pos, len); };
+  stream.feed("hay ne", record);
+  stream.feed("edle hay ", record);
+  stream.feed("need", record);
+  EXPECT_EQ(found, (Matches{{4, 4}, {4, 6}, {15, 4}}));
+}
+
+TEST(AhoCorasick_TEST, MatchesNaiveSearch) {
+  std::mt19937 gen(17);
+  auto random_string = [&](std::size_t len) {
+    std::string s(len, '\0');
+    for (auto &c : s) {
+      c = static_cast<char>("abc\xff"[gen() % 4]);
+    }
+    return s;
+  };
+
+  ming::Trie<char> trie;
+  std::vector<std::string> patterns;
+  for (int i = 0; i < 40; ++i) {
+    patterns.push_back(random_string(1 + gen() % 5));
+    trie.insert(patterns.back());
+  }
+  trie.insert("");
+  std::string const text = random_string(2000);
+
+  std::size_t expected = 0;
+  for (std::size_t pos = 0; pos < text.size(); ++pos) {
+    for (std::size_t len = 1; pos + len <= text.size(); ++len) {
+      expected += trie.is_word(std::string_view(text).substr(pos, len));
+    }
+  }
+
+  auto const ac = trie.compile();
+  std::size_t verified = 0;
+  ac.scan(text, [&](std::size_t pos, std::size_t len) {
+    EXPECT_TRUE(trie.is_word(std::string_view(text).substr(pos, len)));
+    ++verified;
+  });
+  EXPECT_EQ(verified, expected);
+}
+
+} // namespace aho_corasick_test
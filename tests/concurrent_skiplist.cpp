@@ -0,0 +1,199 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <ming/concurrent_skiplist.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace concurrent_skiplist_test {
+
+class ConcurrentSkipListMap_TEST : public ::testing::Test {
+protected:
+  void TearDown() override { ming::EpochReclaimer::instance().synchronize(); }
+
+  ming::ConcurrentSkipListMap<int, std::string> map;
+};
+
+TEST_F(ConcurrentSkipListMap_TEST, BasicOperations) {
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.insert(5, "five"));
+  EXPECT_TRUE(map.insert(3, "three"));
+  EXPECT_TRUE(map.insert(7, "seven"));
+  EXPECT_FALSE(map.insert(5, "five_duplicate"));
+  EXPECT_EQ(map.size(), 3u);
+
+  EXPECT_EQ(map.find(5), "five");
+  EXPECT_EQ(map.find(3), "three");
+  EXPECT_FALSE(map.find(10).has_value());
+  EXPECT_TRUE(map.contains(7));
+  EXPECT_FALSE(map.contains(4));
+
+  EXPECT_TRUE(map.erase(3));
+  EXPECT_FALSE(map.erase(3));
+  EXPECT_FALSE(map.contains(3));
+  EXPECT_EQ(map.size(), 2u);
+
+  EXPECT_TRUE(map.insert(3, "three again"));
+  EXPECT_EQ(map.find(3), "three again");
+}
+
+TEST_F(ConcurrentSkipListMap_TEST, OrderedIteration) {
+  for (int i : {9, 1, 8, 2, 7, 3, 6, 4, 5}) {
+    map.insert(i, std::to_string(i));
+  }
+  map.erase(4);
+
+  std::vector<int> keys;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    auto [key, value] = *it;
+    EXPECT_EQ(value, std::to_string(key));
+    keys.push_back(key);
+  }
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 5, 6, 7, 8, 9}));
+
+  auto it = map.lower_bound(4);
+  ASSERT_NE(it, map.end());
+  EXPECT_EQ((*it).first, 5);
+}
+
+TEST(ConcurrentSkipListMap, ConcurrentDisjointInserts) {
+  constexpr int THREADS = 4;
+  constexpr int PER_THREAD = 2000;
+  ming::ConcurrentSkipListMap<int, int> map;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < THREADS; ++t) {
+    workers.emplace_back([&map, t] {
+      for (int i = 0; i < PER_THREAD; ++i) {
+        int key = i * THREADS + t;
+        EXPECT_TRUE(map.insert(key, key * 2));
+      }
+    });
+  }
+  for (auto &w : workers) {
+    w.join();
+  }
+
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(THREADS * PER_THREAD));
+  int expected = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    auto [key, value] = *it;
+    EXPECT_EQ(key, expected);
+    EXPECT_EQ(value, key * 2);
+    ++expected;
+  }
+  EXPECT_EQ(expected, THREADS * PER_THREAD);
+}
+
+TEST(ConcurrentSkipListMap, ConcurrentInsertEraseSameKeys) {
+  constexpr int THREADS = 4;
+  constexpr int KEYS = 256;
+  constexpr int ROUNDS = 20;
+  ming::ConcurrentSkipListMap<int, int> map;
+  std::atomic<int> inserted{0};
+  std::atomic<int> erased{0};
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < THREADS; ++t) {
+    workers.emplace_back([&] {
+      for (int r = 0; r < ROUNDS; ++r) {
+        for (int k = 0; k < KEYS; ++k) {
+          if (map.insert(k, k)) {
+            inserted.fetch_add(1);
+          }
+          if (auto v = map.find(k)) {
+            EXPECT_EQ(*v, k);
+          }
+          if (map.erase(k)) {
+            erased.fetch_add(1);
+          }
+        }
+      }
+    });
+  }
+  for (auto &w : workers) {
+    w.join();
+  }
+
+  // every successful insert is matched by exactly one successful erase or a
+  // survivor
+  int survivors = 0;
+  int prev = -1;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    EXPECT_LT(prev, (*it).first);
+    prev = (*it).first;
+    ++survivors;
+  }
+  EXPECT_EQ(inserted.load() - erased.load(), survivors);
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(survivors));
+  ming::EpochReclaimer::instance().synchronize();
+}
+
+TEST(ConcurrentSkipListMap, EraseWhileReinsertingSameKey) {
+  // An insert may link its upper levels in front of a node with the same key
+  // that a concurrent erase has already marked; the erase must still unlink that
+  // node everywhere before it is reclaimed
+  constexpr int KEYS = 4;
+  constexpr int ROUNDS = 20000;
+  ming::ConcurrentSkipListMap<int, int> map;
+  std::atomic<int> running{2};
+
+  std::thread eraser([&] {
+    for (int r = 0; r < ROUNDS; ++r) {
+      map.erase(r % KEYS);
+    }
+    running.fetch_sub(1);
+  });
+  std::thread inserter([&] {
+    for (int r = 0; r < ROUNDS; ++r) {
+      map.insert(r % KEYS, r % KEYS);
+    }
+    running.fetch_sub(1);
+  });
+  std::thread reader([&] {
+    while (running.load() > 0) {
+      for (int k = 0; k < KEYS; ++k) {
+        if (auto v = map.find(k)) {
+          EXPECT_EQ(*v, k);
+        }
+      }
+      ming::EpochReclaimer::instance().synchronize();
+    }
+  });
+  eraser.join();
+  inserter.join();
+  reader.join();
+
+  ming::EpochReclaimer::instance().synchronize();
+  int count = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    EXPECT_EQ((*it).first, (*it).second);
+    ++count;
+  }
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(count));
+  for (int k = 0; k < KEYS; ++k) {
+    map.erase(k);
+  }
+  EXPECT_TRUE(map.empty());
+}
+
+} // namespace concurrent_skiplist_test
@@ -0,0 +1,120 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <ming/concurrent_trie.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace concurrent_trie_test {
+
+class ConcurrentTrie_TEST : public ::testing::Test {
+protected:
+  void TearDown() override { ming::EpochReclaimer::instance().synchronize(); }
+
+  ming::ConcurrentTrie trie;
+};
+
+TEST_F(ConcurrentTrie_TEST, BasicOperations) {
+  EXPECT_TRUE(trie.empty());
+  EXPECT_TRUE(trie.insert("word"));
+  EXPECT_FALSE(trie.insert("word"));
+  EXPECT_TRUE(trie.insert("wo"));
+  EXPECT_TRUE(trie.insert("world"));
+  EXPECT_EQ(trie.size(), 3u);
+
+  EXPECT_TRUE(trie.is_word("word"));
+  EXPECT_TRUE(trie.is_word("wo"));
+  EXPECT_FALSE(trie.is_word("wor"));
+  EXPECT_TRUE(trie.starts_with("wor"));
+  EXPECT_FALSE(trie.starts_with("x"));
+
+  EXPECT_FALSE(trie.erase("wor"));
+  EXPECT_TRUE(trie.erase("wo"));
+  EXPECT_FALSE(trie.is_word("wo"));
+  EXPECT_TRUE(trie.is_word("word"));
+  EXPECT_TRUE(trie.erase("world"));
+  EXPECT_TRUE(trie.starts_with("wor"));
+  EXPECT_FALSE(trie.starts_with("worl"));
+  EXPECT_TRUE(trie.erase("word"));
+  EXPECT_FALSE(trie.starts_with("w"));
+  EXPECT_TRUE(trie.empty());
+}
+
+TEST_F(ConcurrentTrie_TEST, PrefixEnumeration) {
+  for (auto const *w : {"cart", "car", "cat", "care", "dog", ""}) {
+    trie.insert(w);
+  }
+  std::vector<std::string> got;
+  trie.for_each_with_prefix("ca", [&](std::string_view w) { got.emplace_back(w); });
+  EXPECT_EQ(got, (std::vector<std::string>{"car", "care", "cart", "cat"}));
+
+  got.clear();
+  trie.for_each_with_prefix("", [&](std::string_view w) { got.emplace_back(w); });
+  EXPECT_EQ(got.size(), 6u);
+  EXPECT_EQ(got.front(), "");
+}
+
+TEST_F(ConcurrentTrie_TEST, ReadersDuringWrites) {
+  for (int i = 0; i < 100; ++i) {
+    trie.insert("stable/" + std::to_string(i));
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<int> failures{0};
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&] {
+      while (!stop.load(std::memory_order_relaxed)) {
+        for (int i = 0; i < 100; ++i) {
+          if (!trie.is_word("stable/" + std::to_string(i))) {
+            failures.fetch_add(1);
+          }
+        }
+        // Each enumeration sees a single version of the churned words
+        std::size_t seen = 0;
+        trie.for_each_with_prefix("churn/", [&](std::string_view) { ++seen; });
+        if (seen > 50) {
+          failures.fetch_add(1);
+        }
+      }
+    });
+  }
+
+  for (int round = 0; round < 200; ++round) {
+    for (int i = 0; i < 50; ++i) {
+      trie.insert("churn/" + std::to_string(i));
+    }
+    for (int i = 0; i < 50; ++i) {
+      trie.erase("churn/" + std::to_string(i));
+    }
+  }
+  stop = true;
+  for (auto &r : readers) {
+    r.join();
+  }
+
+  EXPECT_EQ(failures.load(), 0);
+  EXPECT_EQ(trie.size(), 100u);
+  EXPECT_FALSE(trie.starts_with("churn"));
+}
+
+} // namespace concurrent_trie_test
@@ -0,0 +1,145 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <ming/eviction_policy.hpp>
+#include <ming/weighted_lru.hpp>
+#include <random>
+#include <unordered_map>
+
+namespace eviction_policy_test {
+
+// Random puts, gets and removals; whatever a policy evicts, a hit must return the
+// last value put and the weight must stay within the capacity
+template <typename Policy>
+void check_consistency() {
+  ming::WeightedLRU<int, int, Policy> cache{500};
+  std::unordered_map<int, int> last;
+  std::mt19937 gen(11);
+  for (int i = 0; i < 100000; ++i) {
+    int const key = static_cast<int>(gen() % 300);
+    switch (gen() % 5) {
+    case 0:
+    case 1: {
+      int const size = 1 + static_cast<int>(gen() % 20);
+      cache.put(key, i, size);
+      last[key] = i;
+      // Only LRU promises not to evict an entry that an update made heavier
+      if (auto const e = cache.find(key); e != cache.NOT_CACHED) {
+        ASSERT_EQ(cache.item(e).size, size);
+      }
+      break;
+    }
+    case 2:
+      if (auto const e = cache.find(key); e != cache.NOT_CACHED) {
+        auto const item = cache.extract(e);
+        ASSERT_EQ(item.key, key);
+        ASSERT_EQ(item.value, last[key]);
+      }
+      break;
+    default:
+      if (auto r = cache.get(key)) {
+        ASSERT_EQ(*r, last[key]) << "step " << i;
+      }
+    }
+    ASSERT_LE(cache.weight(), cache.capacity());
+  }
+  int weight = 0;
+  std::size_t size = 0;
+  for (int key = 0; key < 300; ++key) {
+    if (auto const e = cache.find(key); e != cache.NOT_CACHED) {
+      weight += cache.item(e).size;
+      ++size;
+    }
+  }
+  EXPECT_EQ(weight, cache.weight());
+  EXPECT_EQ(size, cache.size());
+}
+
+TEST(EvictionPolicy_TEST, Consistency) {
+  check_consistency<ming::LRUPolicy>();
+  check_consistency<ming::SLRUPolicy>();
+  check_consistency<ming::ARCPolicy>();
+  check_consistency<ming::S3FIFOPolicy>();
+  check_consistency<ming::GDSFPolicy>();
+}
+
+TEST(EvictionPolicy_TEST, SLRUProtectsReusedEntries) {
+  ming::WeightedLRU<int, int, ming::SLRUPolicy> cache{10};
+  for (int key = 0; key < 10; ++key) {
+    cache.put(key, key, 1);
+  }
+  EXPECT_TRUE(cache.get(0));
+  for (int key = 100; key < 120; ++key) {
+    cache.put(key, key, 1);
+  }
+  EXPECT_EQ(cache.get(0).value(), 0);
+  EXPECT_FALSE(cache.get(1));
+}
+
+TEST(EvictionPolicy_TEST, ARCFavoursKeysEvictedTooSoon) {
+  ming::WeightedLRU<int, int, ming::ARCPolicy> cache{4};
+  for (int key = 1; key <= 5; ++key) {
+    cache.put(key, key, 1);
+  }
+  EXPECT_FALSE(cache.get(1));
+  // 1 comes back from the recent ghosts, into the frequent list, and the recent
+  // list's target grows: new keys now evict each other
+  cache.put(1, 1, 1);
+  for (int key = 6; key <= 9; ++key) {
+    cache.put(key, key, 1);
+  }
+  EXPECT_EQ(cache.get(1).value(), 1);
+  EXPECT_EQ(cache.get(9).value(), 9);
+  EXPECT_FALSE(cache.get(5));
+}
+
+TEST(EvictionPolicy_TEST, S3FIFOEvictsOneHitWonders) {
+  ming::WeightedLRU<int, int, ming::S3FIFOPolicy> cache{10};
+  for (int key = 0; key < 10; ++key) {
+    cache.put(key, key, 1);
+  }
+  for (int key = 0; key < 5; ++key) {
+    EXPECT_TRUE(cache.get(key));
+  }
+  for (int key = 100; key < 110; ++key) {
+    cache.put(key, key, 1);
+  }
+  for (int key = 0; key < 5; ++key) {
+    EXPECT_EQ(cache.get(key).value(), key);
+  }
+  for (int key = 5; key < 10; ++key) {
+    EXPECT_FALSE(cache.get(key));
+  }
+}
+
+TEST(EvictionPolicy_TEST, GDSFEvictsLargeEntriesFirst) {
+  ming::WeightedLRU<char, int, ming::GDSFPolicy> cache{10};
+  cache.put('a', 1, 1);
+  cache.put('b', 2, 8);
+  cache.put('c', 3, 1);
+  cache.put('d', 4, 2);
+  EXPECT_FALSE(cache.get('b'));
+  EXPECT_EQ(cache.get('a').value(), 1);
+  EXPECT_EQ(cache.get('c').value(), 3);
+  EXPECT_EQ(cache.get('d').value(), 4);
+  EXPECT_EQ(cache.weight(), 4);
+}
+
+} // namespace eviction_policy_test
@@ -0,0 +1,61 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <ming/frequency_sketch.hpp>
+#include <string>
+
+namespace frequency_sketch_test {
+
+TEST(FrequencySketch_TEST, NeverUnderestimates) {
+  ming::FrequencySketch<int> sketch(1000);
+  for (int key = 0; key < 500; ++key) {
+    for (int i = 0; i < key % 20; ++i) {
+      sketch.increment(key);
+    }
+  }
+  unsigned exact = 0;
+  for (int key = 0; key < 500; ++key) {
+    unsigned const expected = static_cast<unsigned>(std::min(key % 20, 15));
+    EXPECT_GE(sketch.frequency(key), expected) << key;
+    exact += sketch.frequency(key) == expected;
+  }
+  // Collisions are rare at this load
+  EXPECT_GT(exact, 450u);
+  EXPECT_EQ(sketch.frequency(100000), 0u);
+}
+
+TEST(FrequencySketch_TEST, AgingHalves) {
+  ming::FrequencySketch<std::string> sketch(16);
+  for (int i = 0; i < 8; ++i) {
+    sketch.increment("hot");
+  }
+  EXPECT_EQ(sketch.frequency("hot"), 8u);
+  // 160 increments per sample period; fill it with other keys
+  for (int i = 0; sketch.frequency("hot") == 8 && i < 1000; ++i) {
+    sketch.increment("k" + std::to_string(i));
+  }
+  EXPECT_EQ(sketch.frequency("hot"), 4u);
+
+  sketch.clear();
+  EXPECT_EQ(sketch.frequency("hot"), 0u);
+}
+
+} // namespace frequency_sketch_test
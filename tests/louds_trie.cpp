@@ -0,0 +1,138 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ming/trie.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace louds_trie_test {
+
+TEST(LoudsTrie, FreezeSmall) {
+  ming::Trie t{"race", "racing", "racecar", "rapid", "playground", "plump", ""};
+  auto frozen = t.freeze();
+
+  EXPECT_EQ(frozen.size(), 7u);
+  EXPECT_EQ(frozen.node_count(), t.node_count());
+  for (auto w : {"race", "racing", "racecar", "rapid", "playground", "plump", ""}) {
+    EXPECT_TRUE(frozen.is_word(w)) << w;
+  }
+  for (auto w : {"rac", "racecars", "p", "x", "plumped"}) {
+    EXPECT_FALSE(frozen.is_word(w)) << w;
+  }
+  EXPECT_TRUE(frozen.starts_with("raci"));
+  EXPECT_TRUE(frozen.starts_with("pl"));
+  EXPECT_FALSE(frozen.starts_with("plx"));
+
+  std::vector<std::string> completions;
+  frozen.for_each_with_prefix("rac",
+                              [&](std::string_view w) { completions.emplace_back(w); });
+  EXPECT_EQ(completions, (std::vector<std::string>{"race", "racecar", "racing"}));
+
+  completions.clear();
+  frozen.for_each_with_prefix("",
+                              [&](std::string_view w) { completions.emplace_back(w); });
+  EXPECT_EQ(completions.size(), 7u);
+  EXPECT_TRUE(std::ranges::is_sorted(completions));
+
+  completions.clear();
+  frozen.for_each_with_prefix("q",
+                              [&](std::string_view w) { completions.emplace_back(w); });
+  EXPECT_TRUE(completions.empty());
+}
+
+TEST(LoudsTrie, MatchesTrieAndRoundTripsThroughFile) {
+  ming::Trie<char> trie;
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> len(1, 12);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<std::string> words;
+  for (int i = 0; i < 20000; ++i) {
+    std::string w;
+    for (int n = len(gen); n > 0; --n) {
+      // skewed so that prefixes are shared and some nodes are dense
+      w.push_back(static_cast<char>(n > 2 ? byte(gen) % 8 + 'a' : byte(gen)));
+    }
+    words.push_back(w);
+    if (i % 2 == 0) {
+      trie.insert(w);
+    }
+  }
+
+  auto const path = std::filesystem::temp_directory_path() /
+                    ("ming_louds_" + std::to_string(std::random_device{}()));
+  trie.freeze().write(path);
+  auto frozen = ming::LoudsTrie::open(path);
+
+  EXPECT_EQ(frozen.node_count(), trie.node_count());
+  EXPECT_LT(frozen.memory_usage() * 8, frozen.node_count() * 14);
+  for (auto const &w : words) {
+    ASSERT_EQ(frozen.is_word(w), trie.is_word(w)) << w;
+    ASSERT_EQ(frozen.starts_with(w.substr(0, 3)), trie.starts_with(w.substr(0, 3)));
+  }
+
+  EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+  std::ofstream(path, std::ios::app) << "trailing garbage";
+  EXPECT_THROW((void)ming::LoudsTrie::open(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(LoudsTrie, RejectsCorruptDirectories) {
+  ming::Trie<char> trie;
+  for (int i = 0; i < 5000; ++i) {
+    trie.insert("key" + std::to_string(i));
+  }
+  auto const path = std::filesystem::temp_directory_path() /
+                    ("ming_louds_corrupt_" + std::to_string(std::random_device{}()));
+  trie.freeze().write(path);
+
+  std::vector<std::uint64_t> words(std::filesystem::file_size(path) / 8);
+  std::ifstream(path, std::ios::binary)
+      .read(reinterpret_cast<char *>(words.data()),
+            static_cast<std::streamsize>(words.size() * 8));
+  // The header is 10 words; the rank samples follow the shape, then the select hints
+  std::size_t const ranks = 10 + words[5];
+  std::size_t const hints = ranks + words[6];
+  auto const corrupted = [&](std::size_t at, std::uint64_t value) {
+    std::vector<std::uint64_t> copy = words;
+    copy[at] = value;
+    std::ofstream(path, std::ios::binary | std::ios::trunc)
+        .write(reinterpret_cast<char const *>(copy.data()),
+               static_cast<std::streamsize>(copy.size() * 8));
+    return path;
+  };
+
+  EXPECT_NO_THROW((void)ming::LoudsTrie::open(corrupted(ranks, words[ranks])));
+  EXPECT_THROW((void)ming::LoudsTrie::open(corrupted(ranks + 1, words[ranks + 1] + 1)),
+               std::runtime_error);
+  EXPECT_THROW((void)ming::LoudsTrie::open(corrupted(hints + 1, UINT64_MAX)),
+               std::runtime_error);
+  // Swapping the leading "10" would make the root its own first child
+  EXPECT_THROW((void)ming::LoudsTrie::open(corrupted(10, words[10] ^ 0b11)),
+               std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+} // namespace louds_trie_test
@@ -0,0 +1,104 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <ming/radix_trie.hpp>
+#include <ming/trie.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace radix_trie_test {
+
+class RadixTrie_TEST : public ::testing::Test {
+protected:
+  ming::RadixTrie trie;
+};
+
+TEST_F(RadixTrie_TEST, SplitEdges) {
+  trie.insert("romane");
+  EXPECT_EQ(trie.node_count(), 2u);
+  trie.insert("romanus");
+  trie.insert("romulus");
+  trie.insert("rubens");
+  trie.insert("ruber");
+  trie.insert("rubicon");
+  trie.insert("rubicundus");
+  trie.insert("rom");
+
+  for (auto w : {"romane", "romanus", "romulus", "rubens", "ruber", "rubicon",
+                 "rubicundus", "rom"}) {
+    EXPECT_TRUE(trie.is_word(w)) << w;
+  }
+  for (auto w : {"r", "ro", "roman", "rub", "rubi", "rubicons", "x", ""}) {
+    EXPECT_FALSE(trie.is_word(w)) << w;
+  }
+  EXPECT_TRUE(trie.starts_with(""));
+  EXPECT_TRUE(trie.starts_with("rubic"));
+  EXPECT_TRUE(trie.starts_with("rubicu"));
+  EXPECT_TRUE(trie.starts_with("romanu"));
+  EXPECT_FALSE(trie.starts_with("romanz"));
+  EXPECT_FALSE(trie.starts_with("rubicundusx"));
+
+  // root, r, om, an, e, us, ulus, ub, e, ns, r, ic, on, undus
+  EXPECT_EQ(trie.node_count(), 14u);
+}
+
+TEST_F(RadixTrie_TEST, MatchesTrie) {
+  ming::Trie<char> reference;
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> len(0, 8);
+  std::uniform_int_distribution<int> ch('a', 'c');
+  std::vector<std::string> words;
+  for (int i = 0; i < 2000; ++i) {
+    std::string w;
+    for (int n = len(gen); n > 0; --n) {
+      w.push_back(static_cast<char>(ch(gen)));
+    }
+    words.push_back(w);
+    if (i % 2 == 0) {
+      trie.insert(w);
+      reference.insert(w);
+    }
+  }
+  for (auto const &w : words) {
+    ASSERT_EQ(trie.is_word(w), reference.is_word(w)) << w;
+    ASSERT_EQ(trie.starts_with(w), reference.starts_with(w)) << w;
+  }
+  EXPECT_LT(trie.node_count(), reference.node_count());
+
+  auto copy = trie;
+  for (auto const &w : words) {
+    EXPECT_EQ(copy.is_word(w), reference.is_word(w));
+  }
+}
+
+TEST_F(RadixTrie_TEST, PathKeys) {
+  ming::RadixTrie paths{"/usr/share/doc/ming/README",
+                              "/usr/share/doc/ming/COPYING",
+                              "/usr/include/ming/trie.hpp"};
+  EXPECT_TRUE(paths.is_word("/usr/share/doc/ming/README"));
+  EXPECT_FALSE(paths.is_word("/usr/share/doc/ming/"));
+  EXPECT_TRUE(paths.starts_with("/usr/share/doc/ming/"));
+  EXPECT_TRUE(paths.starts_with("/usr/include/mi"));
+  // root, /usr/, share/doc/ming/, README, COPYING, include/ming/trie.hpp
+  EXPECT_EQ(paths.node_count(), 6u);
+}
+
+} // namespace radix_trie_test
@@ -0,0 +1,118 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <ming/sharded_weighted_lru.hpp>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sharded_weighted_lru_test {
+
+TEST(ShardedWeightedLRU_TEST, GetPut) {
+  ming::ShardedWeightedLRU<std::string, int> cache{1600, 16};
+  EXPECT_EQ(cache.shard_count(), 16u);
+  EXPECT_EQ(cache.capacity(), 1600);
+
+  auto r = cache.get("missing");
+  ASSERT_FALSE(r.has_value());
+  EXPECT_EQ(r.error(), "No such key!");
+
+  cache.put("a", 1, 5);
+  cache.put("b", 2, 5);
+  cache.put("a", 3, 7);
+  EXPECT_EQ(cache.get("a").value(), 3);
+  EXPECT_EQ(cache.get("b").value(), 2);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.weight(), 12);
+
+  // Each shard holds 100
+  EXPECT_THROW(cache.put("huge", 0, 101), std::runtime_error);
+  EXPECT_THROW((ming::ShardedWeightedLRU<int, int>{100, 3}), std::invalid_argument);
+}
+
+TEST(ShardedWeightedLRU_TEST, BufferedReadsDecideEviction) {
+  ming::ShardedWeightedLRU<int, int> cache{10, 1};
+  cache.put(1, 1, 4);
+  cache.put(2, 2, 4);
+  // Many reads of 1 overflow the read buffer; recency must still favour it
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(cache.get(1).has_value());
+  }
+  cache.put(3, 3, 4); // evicts 2
+  EXPECT_FALSE(cache.get(2).has_value());
+  EXPECT_TRUE(cache.get(1).has_value());
+  EXPECT_TRUE(cache.get(3).has_value());
+}
+
+TEST(ShardedWeightedLRU_TEST, ConcurrentReadsDecideEviction) {
+  ming::ShardedWeightedLRU<int, int> cache{20, 1};
+  for (int key = 0; key < 14; ++key) {
+    cache.put(key, key, 1);
+  }
+  // Readers of the four oldest keys overflow the read buffer many times over
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 5000; ++i) {
+        EXPECT_TRUE(cache.get(t).has_value());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  // Evicts four keys, which must be the unread ones
+  for (int key = 100; key < 110; ++key) {
+    cache.put(key, key, 1);
+  }
+  for (int key = 0; key < 4; ++key) {
+    EXPECT_TRUE(cache.get(key).has_value()) << key;
+  }
+  EXPECT_EQ(cache.size(), 20u);
+}
+
+TEST(ShardedWeightedLRU_TEST, ConcurrentGetPut) {
+  ming::ShardedWeightedLRU<int, int> cache{4000, 8};
+  std::atomic<bool> wrong{false};
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < 8; ++t) {
+    threads.emplace_back([&, t] {
+      std::mt19937 gen(t);
+      for (int i = 0; i < 20000; ++i) {
+        int const key = static_cast<int>(gen() % 2000);
+        if (gen() % 4 == 0) {
+          cache.put(key, key * 2, 1 + key % 9);
+        } else if (auto r = cache.get(key); r && *r != key * 2) {
+          wrong = true;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_FALSE(wrong);
+  EXPECT_LE(cache.weight(), cache.capacity());
+  EXPECT_GT(cache.size(), 0u);
+}
+
+} // namespace sharded_weighted_lru_test
@@ -18,8 +18,14 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <memory>
 #include <ming/skiplist.hpp>
+#include <random>
+#include <ranges>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace skiplist_test {
 
@@ -84,6 +90,370 @@ TEST_F(SkipList_TEST, BasicOperations) {
   }
 }
 
+TEST_F(SkipList_TEST, Bounds) {
+  for (int i = 0; i < 10; ++i) {
+    skiplist.insert(i * 10, std::to_string(i * 10));
+  }
+
+  EXPECT_EQ((*skiplist.lower_bound(30)).first, 30);
+  EXPECT_EQ((*skiplist.lower_bound(31)).first, 40);
+  EXPECT_EQ((*skiplist.lower_bound(-5)).first, 0);
+  EXPECT_EQ(skiplist.lower_bound(91), skiplist.end());
+
+  EXPECT_EQ((*skiplist.upper_bound(30)).first, 40);
+  EXPECT_EQ((*skiplist.upper_bound(29)).first, 30);
+  EXPECT_EQ(skiplist.upper_bound(90), skiplist.end());
+
+  auto [first, last] = skiplist.equal_range(50);
+  ASSERT_NE(first, skiplist.end());
+  EXPECT_EQ((*first).first, 50);
+  EXPECT_EQ((*last).first, 60);
+
+  auto [missing_first, missing_last] = skiplist.equal_range(55);
+  EXPECT_EQ(missing_first, missing_last);
+}
+
+static_assert(std::ranges::forward_range<ming::SkipList<int, std::string>::range_view>);
+
+TEST_F(SkipList_TEST, RangeView) {
+  for (int i = 0; i < 10; ++i) {
+    skiplist.insert(i * 10, std::to_string(i * 10));
+  }
+
+  std::vector<int> keys;
+  for (auto [key, value] : skiplist.range(25, 60)) {
+    EXPECT_EQ(value, std::to_string(key));
+    keys.push_back(key);
+  }
+  EXPECT_EQ(keys, (std::vector<int>{30, 40, 50}));
+
+  keys.clear();
+  for (auto [key, value] : skiplist.range(80, 1000)) {
+    keys.push_back(key);
+  }
+  EXPECT_EQ(keys, (std::vector<int>{80, 90}));
+
+  EXPECT_TRUE(skiplist.range(41, 49).empty());
+  EXPECT_TRUE(skiplist.range(60, 60).empty());
+  EXPECT_FALSE(skiplist.range(60, 61).empty());
+}
+
+TEST_F(SkipList_TEST, RankAndSelect) {
+  for (int i : {50, 10, 40, 20, 30}) {
+    skiplist.insert(i, std::to_string(i));
+  }
+
+  EXPECT_EQ((*skiplist.at_rank(0)).first, 10);
+  EXPECT_EQ((*skiplist.at_rank(2)).first, 30);
+  EXPECT_EQ((*skiplist.at_rank(4)).first, 50);
+  EXPECT_EQ(skiplist.at_rank(5), skiplist.end());
+
+  EXPECT_EQ(skiplist.rank_of(10), 0u);
+  EXPECT_EQ(skiplist.rank_of(35), 3u);
+  EXPECT_EQ(skiplist.rank_of(50), 4u);
+  EXPECT_EQ(skiplist.rank_of(1000), 5u);
+
+  EXPECT_TRUE(skiplist.erase_at(1));
+  EXPECT_FALSE(skiplist.contains(20));
+  EXPECT_EQ(skiplist.size(), 4u);
+  EXPECT_EQ((*skiplist.at_rank(1)).first, 30);
+  EXPECT_FALSE(skiplist.erase_at(4));
+}
+
+TEST(SkipList, RankMatchesOrderUnderChurn) {
+  ming::SkipList<int, int> sl;
+  std::vector<int> reference;
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> key_dist(0, 500);
+  std::uniform_int_distribution<int> op_dist(0, 3);
+
+  for (int step = 0; step < 3000; ++step) {
+    int key = key_dist(gen);
+    auto pos = std::ranges::lower_bound(reference, key);
+    bool present = pos != reference.end() && *pos == key;
+    switch (op_dist(gen)) {
+    case 0:
+    case 1:
+      EXPECT_EQ(sl.insert(key, key), !present);
+      if (!present) {
+        reference.insert(pos, key);
+      }
+      break;
+    case 2:
+      EXPECT_EQ(sl.erase(key), present);
+      if (present) {
+        reference.erase(pos);
+      }
+      break;
+    default:
+      if (!reference.empty()) {
+        auto rank = static_cast<std::size_t>(key) % reference.size();
+        EXPECT_TRUE(sl.erase_at(rank));
+        reference.erase(reference.begin() + static_cast<std::ptrdiff_t>(rank));
+      }
+      break;
+    }
+
+    ASSERT_EQ(sl.size(), reference.size());
+    EXPECT_EQ(sl.rank_of(key), static_cast<std::size_t>(
+                                   std::ranges::lower_bound(reference, key) -
+                                   reference.begin()));
+  }
+
+  for (std::size_t i = 0; i < reference.size(); ++i) {
+    EXPECT_EQ((*sl.at_rank(i)).first, reference[i]);
+  }
+}
+
+TEST(SkipList, FromSorted) {
+  std::vector<std::pair<int, std::string>> input;
+  for (int i = 0; i < 1000; ++i) {
+    input.emplace_back(i * 2, std::to_string(i * 2));
+  }
+  input.emplace_back(1998, "duplicate");
+
+  for (auto levels : {ming::SkipList<int, std::string>::LevelAssignment::random,
+                      ming::SkipList<int, std::string>::LevelAssignment::balanced}) {
+    auto sl = ming::SkipList<int, std::string>::from_sorted(input, levels);
+    EXPECT_EQ(sl.size(), 1000u);
+
+    std::string value;
+    EXPECT_TRUE(sl.search(1998, value));
+    EXPECT_EQ(value, "1998");
+    EXPECT_FALSE(sl.contains(7));
+    EXPECT_EQ(sl.rank_of(100), 50u);
+    EXPECT_EQ((*sl.at_rank(10)).first, 20);
+
+    // still a regular skiplist afterwards
+    EXPECT_TRUE(sl.insert(7, "seven"));
+    EXPECT_TRUE(sl.erase(8));
+    EXPECT_EQ(sl.rank_of(100), 50u);
+    int prev = -1;
+    for (auto [key, val] : sl) {
+      EXPECT_LT(prev, key);
+      prev = key;
+    }
+  }
+
+  std::vector<std::pair<int, std::string>> unsorted{{2, "two"}, {1, "one"}};
+  EXPECT_THROW((ming::SkipList<int, std::string>::from_sorted(unsorted)),
+               std::invalid_argument);
+}
+
+TEST(SkipList, FromSortedMovesRvalues) {
+  std::vector<std::pair<int, std::string>> input;
+  for (int i = 0; i < 100; ++i) {
+    input.emplace_back(i, std::string(64, static_cast<char>('a' + i % 26)));
+  }
+  auto sl = ming::SkipList<int, std::string>::from_sorted(
+      std::make_move_iterator(input.begin()), std::make_move_iterator(input.end()));
+  EXPECT_EQ(sl.size(), 100u);
+  std::string value;
+  EXPECT_TRUE(sl.search(3, value));
+  EXPECT_EQ(value, std::string(64, 'd'));
+  EXPECT_TRUE(
+      std::ranges::all_of(input, [](auto const &p) { return p.second.empty(); }));
+
+  // Move-only values are accepted as long as the input yields rvalues
+  std::vector<std::pair<int, std::unique_ptr<int>>> owned;
+  owned.emplace_back(1, std::make_unique<int>(10));
+  owned.emplace_back(2, std::make_unique<int>(20));
+  auto ptrs = ming::SkipList<int, std::unique_ptr<int>>::from_sorted(
+      owned | std::views::transform([](auto &p) { return std::move(p); }));
+  EXPECT_EQ(ptrs.size(), 2u);
+  EXPECT_EQ(owned[0].second, nullptr);
+}
+
+TEST(SkipList, LevelOptions) {
+  ming::SkipListOptions options;
+  options.probability = 0.25;
+  options.max_level = 6;
+  options.seed = 42;
+
+  ming::SkipList<int, int> a(options);
+  ming::SkipList<int, int> b(options);
+  for (int i = 0; i < 5000; ++i) {
+    a.insert(i, i);
+    b.insert(i, i);
+    // same seed, same towers
+    ASSERT_EQ(a.level(), b.level());
+  }
+  EXPECT_LE(a.level(), 6);
+  EXPECT_GT(a.level(), 1);
+  EXPECT_EQ(a.rank_of(1234), 1234u);
+  EXPECT_EQ((*a.at_rank(4321)).first, 4321);
+
+  // copies continue the same random sequence
+  auto c = a;
+  for (int i = 5000; i < 6000; ++i) {
+    a.insert(i, i);
+    c.insert(i, i);
+  }
+  EXPECT_EQ(a.level(), c.level());
+
+  ming::SkipList<int, int, std::less<int>, 4> capped;
+  for (int i = 0; i < 5000; ++i) {
+    capped.insert(i, i);
+  }
+  EXPECT_LE(capped.level(), 4);
+  EXPECT_EQ(capped.size(), 5000u);
+
+  std::vector<std::pair<int, int>> input;
+  for (int i = 0; i < 64; ++i) {
+    input.emplace_back(i, i);
+  }
+  auto balanced = ming::SkipList<int, int>::from_sorted(
+      input, ming::SkipList<int, int>::LevelAssignment::balanced, {}, options);
+  // 64 nodes at P = 1/4: one tower of 4 levels at position 64
+  EXPECT_EQ(balanced.level(), 4);
+
+  EXPECT_THROW((ming::SkipList<int, int>(ming::SkipListOptions{.probability = 0.3})),
+               std::invalid_argument);
+  EXPECT_THROW((ming::SkipList<int, int>(ming::SkipListOptions{.max_level = 33})),
+               std::invalid_argument);
+}
+
+TEST(SkipList, Merge) {
+  ming::SkipList<int, std::string> a;
+  ming::SkipList<int, std::string> b;
+  for (int i = 0; i < 100; i += 2) {
+    a.insert(i, "a");
+  }
+  for (int i = 0; i < 100; i += 3) {
+    b.insert(i, "b");
+  }
+
+  a.merge(b);
+
+  // keys divisible by 6 were in both lists and stay behind in b
+  EXPECT_EQ(a.size(), 67u);
+  EXPECT_EQ(b.size(), 17u);
+  std::string value;
+  EXPECT_TRUE(a.search(6, value));
+  EXPECT_EQ(value, "a");
+  EXPECT_TRUE(a.search(9, value));
+  EXPECT_EQ(value, "b");
+  EXPECT_TRUE(b.contains(6));
+  EXPECT_FALSE(b.contains(9));
+
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    EXPECT_EQ(a.rank_of((*a.at_rank(i)).first), i);
+  }
+  EXPECT_TRUE(b.insert(9, "b"));
+  EXPECT_EQ(b.rank_of(9), 2u);
+}
+
+TEST(SkipList, CopyIsDeep) {
+  ming::SkipList<int, std::string> a;
+  a.insert(1, "one");
+  a.insert(2, "two");
+
+  auto b = a;
+  b.insert(3, "three");
+  b.erase(1);
+  EXPECT_TRUE(a.contains(1));
+  EXPECT_FALSE(a.contains(3));
+  EXPECT_EQ(a.size(), 2u);
+  EXPECT_EQ(b.size(), 2u);
+
+  a = std::move(b);
+  EXPECT_TRUE(a.contains(3));
+  a.clear();
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.begin(), a.end());
+}
+
+TEST(SkipList, EmplaceFamily) {
+  ming::SkipList<std::string, std::unique_ptr<int>> sl;
+
+  auto [it, inserted] = sl.emplace("a", std::make_unique<int>(1));
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*(*it).second, 1);
+
+  auto value = std::make_unique<int>(2);
+  auto [dup, dup_inserted] = sl.try_emplace("a", std::move(value));
+  EXPECT_FALSE(dup_inserted);
+  EXPECT_NE(value, nullptr) << "try_emplace must not move from args on a hit";
+  EXPECT_EQ(*(*dup).second, 1);
+
+  std::string key = "b";
+  EXPECT_TRUE(sl.try_emplace(std::move(key), std::move(value)).second);
+  EXPECT_EQ(value, nullptr);
+  EXPECT_EQ(*(*sl.find("b")).second, 2);
+
+  auto [assigned, assigned_inserted] =
+      sl.insert_or_assign("a", std::make_unique<int>(10));
+  EXPECT_FALSE(assigned_inserted);
+  EXPECT_EQ(*(*assigned).second, 10);
+  EXPECT_TRUE(sl.insert_or_assign("c", std::make_unique<int>(3)).second);
+
+  EXPECT_TRUE(sl.insert("d", std::make_unique<int>(4)));
+  EXPECT_EQ(sl.size(), 4u);
+  EXPECT_EQ(sl.rank_of("c"), 2u);
+}
+
+TEST(SkipList, TransparentLookup) {
+  ming::SkipList<std::string, int, std::less<>> sl;
+  sl.insert("apple", 1);
+  sl.insert("banana", 2);
+
+  std::string_view key = "banana";
+  auto it = sl.find(key);
+  ASSERT_NE(it, sl.end());
+  EXPECT_EQ((*it).second, 2);
+  EXPECT_TRUE(sl.contains(std::string_view{"apple"}));
+  EXPECT_FALSE(sl.contains(std::string_view{"cherry"}));
+  EXPECT_EQ(sl.find(std::string_view{"cherry"}), sl.end());
+}
+
+TEST(SkipList, StringKeysWithSharedPrefixes) {
+  // keys that tie on the cached 8-byte prefix, or are prefixes of each other, must
+  // fall back to full comparisons
+  ming::SkipList<std::string, int> sl;
+  std::vector<std::string> reference;
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> dist(0, 300);
+
+  for (int step = 0; step < 2000; ++step) {
+    int n = dist(gen);
+    std::string key = (n % 3 == 0) ? std::string("/usr/lib").substr(0, n % 9)
+                                   : "/usr/lib/" + std::to_string(n);
+    if (n % 5 == 0) {
+      key.push_back('\0');
+    }
+    auto pos = std::ranges::lower_bound(reference, key);
+    bool present = pos != reference.end() && *pos == key;
+    if (n % 2 == 0) {
+      EXPECT_EQ(sl.insert(key, n), !present);
+      if (!present) {
+        reference.insert(pos, key);
+      }
+    } else {
+      EXPECT_EQ(sl.erase(key), present);
+      if (present) {
+        reference.erase(pos);
+      }
+    }
+    EXPECT_EQ(sl.rank_of(key), static_cast<std::size_t>(
+                                   std::ranges::lower_bound(reference, key) -
+                                   reference.begin()));
+    auto upper = sl.upper_bound(key);
+    auto expected = std::ranges::upper_bound(reference, key);
+    if (expected == reference.end()) {
+      EXPECT_EQ(upper, sl.end());
+    } else {
+      ASSERT_NE(upper, sl.end());
+      EXPECT_EQ((*upper).first, *expected);
+    }
+  }
+
+  std::vector<std::string> keys;
+  for (auto [key, value] : sl) {
+    keys.push_back(key);
+  }
+  EXPECT_EQ(keys, reference);
+}
+
 class SkipListReverseComp_TEST : public ::testing::Test {
 protected:
   SkipListReverseComp_TEST() = default;
@@ -0,0 +1,161 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ming/skiplist.hpp>
+#include <ming/sorted_run.hpp>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sorted_run_test {
+
+class SortedRun_TEST : public ::testing::Test {
+protected:
+  void SetUp() override {
+    dir = std::filesystem::temp_directory_path() /
+          ("ming_sorted_run_" + std::to_string(std::random_device{}()));
+    std::filesystem::create_directories(dir);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(dir); }
+
+  std::filesystem::path dir;
+};
+
+TEST_F(SortedRun_TEST, FlushSkipList) {
+  ming::SkipList<int, std::string> memtable;
+  for (int i = 0; i < 5000; ++i) {
+    memtable.insert(i * 3, "value" + std::to_string(i * 3));
+  }
+
+  ming::SortedRunOptions options;
+  options.block_size = 256;
+  auto run = ming::SortedRun<int, std::string>::write(dir / "run", memtable, options);
+  EXPECT_EQ(run.size(), 5000u);
+  EXPECT_FALSE(std::filesystem::exists(dir / "run.tmp"));
+
+  for (int i = 0; i < 5000; ++i) {
+    EXPECT_EQ(run.find(i * 3), "value" + std::to_string(i * 3));
+  }
+  int false_positives = 0;
+  for (int i = 0; i < 5000; ++i) {
+    EXPECT_FALSE(run.contains(i * 3 + 1));
+    false_positives += run.may_contain(i * 3 + 1);
+  }
+  EXPECT_LT(false_positives, 250);
+  EXPECT_FALSE(run.contains(-1));
+  EXPECT_FALSE(run.contains(15000));
+
+  // reopen from disk
+  ming::SortedRun<int, std::string> reopened(dir / "run");
+  std::vector<int> keys;
+  for (auto const &[key, value] : reopened.range(100, 130)) {
+    EXPECT_EQ(value, "value" + std::to_string(key));
+    keys.push_back(key);
+  }
+  EXPECT_EQ(keys, (std::vector<int>{102, 105, 108, 111, 114, 117, 120, 123, 126, 129}));
+
+  auto it = reopened.lower_bound(14996);
+  ASSERT_NE(it, reopened.end());
+  EXPECT_EQ(it->first, 14997);
+  EXPECT_EQ(++it, reopened.end());
+
+  int count = 0;
+  int prev = -1;
+  for (auto const &[key, value] : reopened) {
+    EXPECT_LT(prev, key);
+    prev = key;
+    ++count;
+  }
+  EXPECT_EQ(count, 5000);
+}
+
+TEST_F(SortedRun_TEST, StringKeysWithoutBloom) {
+  std::vector<std::pair<std::string, double>> input;
+  for (int i = 0; i < 1000; ++i) {
+    input.emplace_back("key" + std::to_string(100000 + i), i * 0.5);
+  }
+
+  ming::SortedRunOptions options;
+  options.block_size = 100;
+  options.bloom_bits_per_key = 0;
+  auto run =
+      ming::SortedRun<std::string, double>::write(dir / "strings", input, options);
+
+  EXPECT_TRUE(run.may_contain("nope"));
+  EXPECT_EQ(run.find("key100500"), 250.0);
+  EXPECT_FALSE(run.find("key1005000").has_value());
+  EXPECT_FALSE(run.find("a").has_value());
+  EXPECT_TRUE(run.range("key2", "key3").empty());
+  EXPECT_EQ((*run.begin()).first, "key100000");
+}
+
+TEST_F(SortedRun_TEST, EmptyAndInvalid) {
+  std::vector<std::pair<int, int>> empty;
+  auto run = ming::SortedRun<int, int>::write(dir / "empty", empty);
+  EXPECT_TRUE(run.empty());
+  EXPECT_EQ(run.begin(), run.end());
+  EXPECT_FALSE(run.contains(0));
+
+  std::vector<std::pair<int, int>> unsorted{{2, 2}, {1, 1}};
+  EXPECT_THROW((ming::SortedRun<int, int>::write(dir / "unsorted", unsorted)),
+               std::invalid_argument);
+  EXPECT_FALSE(std::filesystem::exists(dir / "unsorted"));
+
+  EXPECT_FALSE(std::filesystem::exists(dir / "unsorted.tmp"));
+
+  auto failing = std::views::iota(0, 100) | std::views::transform([](int i) {
+                   if (i == 50) {
+                     throw std::runtime_error("source failed");
+                   }
+                   return std::pair{i, i};
+                 });
+  EXPECT_THROW((ming::SortedRun<int, int>::write(dir / "failing", failing)),
+               std::runtime_error);
+  EXPECT_FALSE(std::filesystem::exists(dir / "failing"));
+  EXPECT_FALSE(std::filesystem::exists(dir / "failing.tmp"));
+
+  std::ofstream(dir / "garbage") << "definitely not a sorted run, but long enough";
+  EXPECT_THROW((ming::SortedRun<int, int>(dir / "garbage")), std::runtime_error);
+  EXPECT_THROW((ming::SortedRun<int, int>(dir / "missing")), std::runtime_error);
+}
+
+TEST_F(SortedRun_TEST, CorruptFooterCounts) {
+  std::vector<std::pair<int, int>> pairs{{1, 1}, {2, 2}, {3, 3}};
+  ming::SortedRun<int, int>::write(dir / "run", pairs);
+
+  // Overwrite index_count, the fifth field of the 64-byte footer, with a count
+  // far larger than the index section could hold
+  {
+    std::fstream file(dir / "run", std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(-64 + 4 * 8, std::ios::end);
+    std::uint64_t const huge = std::uint64_t{1} << 60;
+    file.write(reinterpret_cast<char const *>(&huge), sizeof(huge));
+  }
+  EXPECT_THROW((ming::SortedRun<int, int>(dir / "run")), std::runtime_error);
+}
+
+} // namespace sorted_run_test
@@ -0,0 +1,121 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <ming/tiny_lfu.hpp>
+#include <ming/weighted_lru.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace tiny_lfu_test {
+
+TEST(TinyLFU_TEST, GetPut) {
+  ming::TinyLFU<std::string, int> cache{1000};
+  EXPECT_EQ(cache.capacity(), 1000);
+
+  auto r = cache.get("missing");
+  ASSERT_FALSE(r.has_value());
+  EXPECT_EQ(r.error(), "No such key!");
+
+  cache.put("a", 1, 5);
+  cache.put("b", 2, 5);
+  EXPECT_EQ(cache.get("a").value(), 1);
+  cache.put("a", 3, 4);
+  EXPECT_EQ(cache.get("a").value(), 3);
+  EXPECT_EQ(cache.get("b").value(), 2);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.weight(), 9);
+  EXPECT_THROW(cache.put("huge", 0, 995), std::runtime_error);
+}
+
+TEST(TinyLFU_TEST, SmallCapacity) {
+  EXPECT_THROW((ming::TinyLFU<int, int>{0}), std::invalid_argument);
+
+  // The main cache keeps the whole budget rather than handing it to the window
+  ming::TinyLFU<int, int> one{1};
+  EXPECT_EQ(one.capacity(), 1);
+  one.put(1, 10, 1);
+  EXPECT_EQ(one.get(1).value(), 10);
+  one.put(1, 11, 1);
+  EXPECT_EQ(one.get(1).value(), 11);
+  // A newcomer seen no more often than the resident is not admitted
+  one.put(2, 20, 1);
+  EXPECT_FALSE(one.get(2).has_value());
+  EXPECT_EQ(one.size(), 1u);
+  EXPECT_EQ(one.weight(), 1);
+
+  ming::TinyLFU<int, int> two{2};
+  EXPECT_EQ(two.capacity(), 2);
+  two.put(1, 10, 1);
+  two.put(2, 20, 1);
+  EXPECT_EQ(two.get(1).value(), 10);
+  EXPECT_EQ(two.get(2).value(), 20);
+  EXPECT_THROW(two.put(3, 30, 2), std::runtime_error);
+}
+
+TEST(TinyLFU_TEST, WeightStaysWithinCapacity) {
+  ming::TinyLFU<int, int> cache{500};
+  for (int i = 0; i < 20000; ++i) {
+    int const key = (i * 7919) % 1000;
+    if (!cache.get(key)) {
+      cache.put(key, key, 1 + key % 30);
+    }
+    ASSERT_LE(cache.weight(), cache.capacity());
+  }
+  for (int key = 0; key < 1000; ++key) {
+    if (auto r = cache.get(key)) {
+      EXPECT_EQ(*r, key);
+    }
+  }
+}
+
+TEST(TinyLFU_TEST, ScanDoesNotFlushHotEntries) {
+  ming::TinyLFU<int, int> tiny{200};
+  ming::WeightedLRU<int, int> lru{200};
+  auto access = [](auto &cache, int key) {
+    if (!cache.get(key)) {
+      cache.put(key, key, 1);
+    }
+  };
+  for (int round = 0; round < 20; ++round) {
+    for (int key = 0; key < 100; ++key) {
+      access(tiny, key);
+      access(lru, key);
+    }
+  }
+  // A long scan of keys that are never seen again, while the hot keys are still
+  // used: one hot access for every three scanned keys
+  int tiny_hits = 0;
+  int lru_hits = 0;
+  for (int i = 0; i < 12000; ++i) {
+    int const key = i % 4 == 0 ? (i / 4) % 100 : 1000 + i;
+    if (key < 100) {
+      tiny_hits += tiny.get(key).has_value();
+      lru_hits += lru.get(key).has_value();
+    }
+    access(tiny, key);
+    access(lru, key);
+  }
+  // A hot key comes back after 400 accesses, beyond what LRU can keep once the
+  // scan has pushed out the warm-up
+  EXPECT_GT(tiny_hits, 1500);
+  EXPECT_LT(lru_hits, 100);
+}
+
+} // namespace tiny_lfu_test
@@ -18,7 +18,14 @@
 
 #include "gtest/gtest.h"
 
+#include <memory>
 #include <ming/trie.hpp>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace trie_test {
 
@@ -88,4 +95,225 @@ TEST_F(Trie_TEST, TrieMoved) {
   EXPECT_FALSE(t_copied.starts_with("po"));
 }
 
+TEST_F(Trie_TEST, TrieDeepCopyClear) {
+  // a key far longer than any recursion could survive
+  std::string const deep(1 << 20, 'x');
+  trie.insert(deep);
+  trie.insert("xy", 7);
+  {
+    ming::Trie<char> copy(trie);
+    EXPECT_TRUE(copy.is_word(deep));
+    EXPECT_EQ(copy.score("xy"), 7u);
+    EXPECT_EQ(copy.node_count(), trie.node_count());
+  }
+
+  std::size_t const reserved = trie.memory_usage();
+  trie.clear();
+  EXPECT_FALSE(trie.is_word(deep));
+  EXPECT_FALSE(trie.starts_with("x"));
+  EXPECT_EQ(trie.score("xy"), 0u);
+  EXPECT_EQ(trie.node_count(), 1u);
+  EXPECT_EQ(trie.memory_usage(), reserved);
+
+  trie.insert("xy");
+  EXPECT_TRUE(trie.is_word("xy"));
+  EXPECT_FALSE(trie.is_word("x"));
+}
+
+TEST_F(Trie_TEST, TrieWideFanout) {
+  // push the root through every child representation, up to a direct table
+  std::vector<std::string> words;
+  for (int c = 255; c >= 0; --c) {
+    std::string word(1, static_cast<char>(c));
+    word += "tail";
+    words.push_back(word);
+    trie.insert(word);
+    for (auto const &w : words) {
+      ASSERT_TRUE(trie.is_word(w));
+    }
+  }
+  EXPECT_FALSE(trie.is_word(std::string(1, 'a')));
+  EXPECT_TRUE(trie.starts_with(std::string(1, '\0')));
+  EXPECT_TRUE(trie.starts_with("ztai"));
+  EXPECT_FALSE(trie.starts_with("ztx"));
+  EXPECT_EQ(trie.node_count(), 1u + 256u * 5u);
+
+  auto copy = trie;
+  for (auto const &w : words) {
+    EXPECT_TRUE(copy.is_word(w));
+  }
+}
+
+TEST_F(Trie_TEST, TrieEmptyWord) {
+  EXPECT_FALSE(trie.is_word(""));
+  EXPECT_TRUE(trie.starts_with(""));
+  trie.insert("");
+  EXPECT_TRUE(trie.is_word(""));
+  trie.insert("a");
+  EXPECT_TRUE(trie.is_word("a"));
+  EXPECT_FALSE(trie.is_word("aa"));
+}
+
+TEST_F(Trie_TEST, TrieCompletions) {
+  static_assert(std::ranges::input_range<ming::Trie<char>::completion_range>);
+  for (auto const *w : {"car", "cart", "care", "cat", "dog", "ca"}) {
+    trie.insert(w);
+  }
+
+  std::vector<std::string> got;
+  trie.for_each_with_prefix("ca", [&](std::string_view w) { got.emplace_back(w); });
+  EXPECT_EQ(got, (std::vector<std::string>{"ca", "car", "care", "cart", "cat"}));
+
+  got.clear();
+  for (std::string_view w : trie.completions("car")) {
+    got.emplace_back(w);
+  }
+  EXPECT_EQ(got, (std::vector<std::string>{"car", "care", "cart"}));
+
+  got.clear();
+  for (std::string_view w : trie.completions("")) {
+    got.emplace_back(w);
+  }
+  EXPECT_EQ(got.size(), 6u);
+  EXPECT_EQ(got.front(), "ca");
+  EXPECT_EQ(got.back(), "dog");
+
+  auto missing = trie.completions("x");
+  EXPECT_TRUE(missing.begin() == missing.end());
+}
+
+TEST_F(Trie_TEST, TrieTopK) {
+  using Scored = std::vector<std::pair<std::string, ming::Trie<char>::score_type>>;
+  trie.insert("car", 5);
+  trie.insert("cart", 9);
+  trie.insert("care", 7);
+  trie.insert("cat", 7);
+  trie.insert("dog", 100);
+  trie.insert("ca");
+
+  EXPECT_EQ(trie.top_k("ca", 3), (Scored{{"cart", 9}, {"care", 7}, {"cat", 7}}));
+  EXPECT_EQ(trie.top_k("", 1), (Scored{{"dog", 100}}));
+  EXPECT_EQ(trie.top_k("ca", 10).size(), 5u);
+  EXPECT_EQ(trie.top_k("ca", 10).back(), (std::pair<std::string, unsigned>{"ca", 0}));
+  EXPECT_TRUE(trie.top_k("x", 3).empty());
+  EXPECT_TRUE(trie.top_k("ca", 0).empty());
+
+  // Lowering a score must lower the subtree maxima above it
+  trie.insert("cart", 1);
+  EXPECT_EQ(trie.score("cart"), 1u);
+  EXPECT_EQ(trie.top_k("car", 2), (Scored{{"care", 7}, {"car", 5}}));
+  trie.insert("care", 0);
+  EXPECT_EQ(trie.top_k("car", 1), (Scored{{"car", 5}}));
+  EXPECT_EQ(trie.score("nope"), 0u);
+}
+
+TEST_F(Trie_TEST, TrieIsWordBatch) {
+  std::mt19937 gen(9);
+  auto random_word = [&] {
+    std::string w(gen() % 6, '\0');
+    for (auto &c : w) {
+      c = static_cast<char>('a' + gen() % 20);
+    }
+    return w;
+  };
+  for (int i = 0; i < 3000; ++i) {
+    trie.insert(random_word());
+  }
+
+  std::vector<std::string> tokens;
+  for (int i = 0; i < 1001; ++i) {
+    tokens.push_back(random_word());
+  }
+  std::vector<std::string_view> views(tokens.begin(), tokens.end());
+  auto out = std::make_unique<bool[]>(views.size());
+  std::span<bool> const result(out.get(), views.size());
+  std::size_t const found = trie.is_word_batch(views, result);
+
+  std::size_t expected = 0;
+  for (std::size_t i = 0; i < views.size(); ++i) {
+    EXPECT_EQ(out[i], trie.is_word(views[i])) << views[i];
+    expected += trie.is_word(views[i]);
+  }
+  EXPECT_EQ(found, expected);
+  EXPECT_EQ(trie.is_word_batch({}, {}), 0u);
+  EXPECT_THROW(trie.is_word_batch(views, result.first(3)), std::invalid_argument);
+}
+
+TEST(TrieWide_TEST, NativeWideStrings) {
+  ming::Trie<char32_t> wide{U"\u65e5\u672c", U"\u65e5\u672c\u8a9e", U"\U0001f600"};
+  EXPECT_TRUE(wide.is_word(U"\u65e5\u672c"));
+  EXPECT_FALSE(wide.is_word(U"\u65e5"));
+  EXPECT_TRUE(wide.starts_with(U"\u65e5"));
+  EXPECT_TRUE(wide.is_word(std::u32string(U"\U0001f600")));
+  // characters share no bytes with their neighbours by accident
+  EXPECT_FALSE(wide.starts_with(U"\u65e6"));
+
+  std::vector<char32_t> const chars{U'a', U'\u00e9'};
+  wide.insert(chars);
+  EXPECT_TRUE(wide.is_word(U"a\u00e9"));
+  EXPECT_TRUE(wide.is_word(chars));
+  EXPECT_TRUE(wide.starts_with(std::vector<char32_t>{U'a'}));
+
+  // completions come back whole and in code point order
+  std::vector<std::u32string> words;
+  wide.for_each_with_prefix(U"", [&](std::u32string_view w) { words.emplace_back(w); });
+  std::vector<std::u32string> const expected{U"a\u00e9", U"\u65e5\u672c",
+                                             U"\u65e5\u672c\u8a9e", U"\U0001f600"};
+  EXPECT_EQ(words, expected);
+}
+
+TEST(TrieWide_TEST, ScoresAndBatch) {
+  ming::Trie<char16_t> wide;
+  wide.insert(u"\u0430\u0431", 5);
+  wide.insert(u"\u0430\u0432", 9);
+  wide.insert(u"\u0431", 1);
+  EXPECT_EQ(wide.score(u"\u0430\u0432"), 9u);
+  using Scored = std::vector<std::pair<std::u16string, std::uint32_t>>;
+  EXPECT_EQ(wide.top_k(u"\u0430", 5),
+            (Scored{{u"\u0430\u0432", 9}, {u"\u0430\u0431", 5}}));
+
+  std::vector<std::u16string_view> const views{u"\u0431", u"\u0430", u"\u0430\u0431"};
+  bool out[3];
+  EXPECT_EQ(wide.is_word_batch(views, out), 2u);
+  EXPECT_TRUE(out[0]);
+  EXPECT_FALSE(out[1]);
+  EXPECT_TRUE(out[2]);
+}
+
+TEST(TrieWide_TEST, NibbleSplit) {
+  ming::Trie<char, ming::TrieSplit::nibble> nibbles;
+  ming::Trie<char> bytes;
+  std::mt19937 gen(11);
+  std::vector<std::string> words;
+  for (int i = 0; i < 2000; ++i) {
+    std::string w(gen() % 8, '\0');
+    for (auto &c : w) {
+      c = static_cast<char>(gen());
+    }
+    words.push_back(w);
+    nibbles.insert(w, static_cast<std::uint32_t>(gen() % 100));
+    bytes.insert(w);
+  }
+
+  for (auto const &w : words) {
+    EXPECT_TRUE(nibbles.is_word(w));
+    std::string const longer = w + "\xff";
+    EXPECT_EQ(nibbles.is_word(longer), bytes.is_word(longer));
+    EXPECT_EQ(nibbles.starts_with(w.substr(0, 2)), bytes.starts_with(w.substr(0, 2)));
+  }
+
+  std::vector<std::string> expected;
+  std::vector<std::string> got;
+  bytes.for_each_with_prefix("", [&](std::string_view w) { expected.emplace_back(w); });
+  for (std::string_view w : nibbles.completions("")) {
+    got.emplace_back(w);
+  }
+  EXPECT_EQ(got, expected);
+
+  auto const best = nibbles.top_k("", 3);
+  ASSERT_EQ(best.size(), 3u);
+  EXPECT_EQ(best[0].second, nibbles.score(best[0].first));
+  EXPECT_GE(best[0].second, best[2].second);
+}
+
 } // namespace trie_test
\ No newline at end of file
@@ -0,0 +1,155 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <memory>
+#include <ming/trie_map.hpp>
+#include <random>
+#include <string>
+
+namespace trie_map_test {
+
+class TrieMap_TEST : public ::testing::Test {
+protected:
+  TrieMap_TEST() = default;
+
+  virtual ~TrieMap_TEST() {}
+
+  virtual void SetUp() {
+    // post-construction
+  }
+
+  virtual void TearDown() {
+    // pre-destruction
+  }
+
+  ming::TrieMap<int> map;
+};
+
+TEST_F(TrieMap_TEST, InsertFind) {
+  EXPECT_EQ(map.find("a"), nullptr);
+  auto [value, inserted] = map.insert_or_assign("apple", 1);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*value, 1);
+  EXPECT_TRUE(map.insert_or_assign("app", 2).second);
+  EXPECT_FALSE(map.insert_or_assign("apple", 3).second);
+
+  EXPECT_EQ(*map.find("apple"), 3);
+  EXPECT_EQ(*map.find("app"), 2);
+  EXPECT_EQ(map.find("ap"), nullptr);
+  EXPECT_EQ(map.find("apples"), nullptr);
+  EXPECT_TRUE(map.contains("app"));
+  EXPECT_EQ(map.size(), 2u);
+
+  *map.find("app") = 20;
+  EXPECT_EQ(*std::as_const(map).find("app"), 20);
+}
+
+TEST_F(TrieMap_TEST, ErasePrunes) {
+  map.insert_or_assign("romane", 1);
+  map.insert_or_assign("romanus", 2);
+  map.insert_or_assign("roman", 3);
+  std::size_t const nodes = map.node_count();
+
+  EXPECT_FALSE(map.erase("rom"));
+  EXPECT_FALSE(map.erase("romanes"));
+  EXPECT_TRUE(map.erase("romanus"));
+  EXPECT_FALSE(map.erase("romanus"));
+  // "us" below "roman" is gone
+  EXPECT_EQ(map.node_count(), nodes - 2);
+  EXPECT_EQ(*map.find("romane"), 1);
+  EXPECT_EQ(*map.find("roman"), 3);
+
+  // "roman" still has a child, so it only loses its value
+  EXPECT_TRUE(map.erase("roman"));
+  EXPECT_EQ(map.node_count(), nodes - 2);
+  EXPECT_EQ(map.find("roman"), nullptr);
+
+  EXPECT_TRUE(map.erase("romane"));
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.node_count(), 1u);
+
+  // Freed nodes are reused
+  map.insert_or_assign("romanus", 4);
+  EXPECT_EQ(map.node_count(), 8u);
+  EXPECT_EQ(*map.find("romanus"), 4);
+}
+
+TEST_F(TrieMap_TEST, EmptyKey) {
+  map.insert_or_assign("", 7);
+  map.insert_or_assign("a", 8);
+  EXPECT_EQ(*map.find(""), 7);
+  EXPECT_TRUE(map.erase(""));
+  EXPECT_EQ(map.find(""), nullptr);
+  EXPECT_EQ(*map.find("a"), 8);
+}
+
+TEST_F(TrieMap_TEST, LongestPrefixMatch) {
+  map.insert_or_assign("/", 0);
+  map.insert_or_assign("/api/", 1);
+  map.insert_or_assign("/api/v2/", 2);
+
+  auto [prefix, value] = map.longest_prefix_match("/api/v2/users");
+  EXPECT_EQ(prefix, "/api/v2/");
+  EXPECT_EQ(*value, 2);
+  EXPECT_EQ(*map.longest_prefix_match("/api/v1/users").second, 1);
+  EXPECT_EQ(map.longest_prefix_match("/static").first, "/");
+  EXPECT_EQ(map.longest_prefix_match("api").second, nullptr);
+  EXPECT_EQ(map.longest_prefix_match("api").first, "");
+}
+
+TEST_F(TrieMap_TEST, WideFanoutChurn) {
+  // Grow and shrink nodes through every representation, checked against std::map
+  std::map<std::string, int> expected;
+  std::mt19937 gen(3);
+  for (int round = 0; round < 20000; ++round) {
+    std::string key(1 + gen() % 3, '\0');
+    for (auto &c : key) {
+      c = static_cast<char>(gen() % 256);
+    }
+    if (gen() % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key) == 1);
+    } else {
+      map.insert_or_assign(key, round);
+      expected[key] = round;
+    }
+  }
+  EXPECT_EQ(map.size(), expected.size());
+  for (auto const &[key, value] : expected) {
+    ASSERT_NE(map.find(key), nullptr);
+    EXPECT_EQ(*map.find(key), value);
+  }
+  for (auto const &[key, value] : expected) {
+    EXPECT_TRUE(map.erase(key));
+  }
+  EXPECT_EQ(map.node_count(), 1u);
+}
+
+TEST_F(TrieMap_TEST, MoveOnlyValues) {
+  ming::TrieMap<std::unique_ptr<int>> owned;
+  owned.insert_or_assign("a", std::make_unique<int>(1));
+  owned.insert_or_assign("b", std::make_unique<int>(2));
+  EXPECT_TRUE(owned.erase("a"));
+  EXPECT_EQ(**owned.find("b"), 2);
+  auto copy_free = std::move(owned);
+  EXPECT_EQ(**copy_free.find("b"), 2);
+}
+
+} // namespace trie_map_test
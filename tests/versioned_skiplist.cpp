@@ -0,0 +1,145 @@
+//
+// ming   C++ containers library
+// Copyright (C) 2022-2026 John Law
+//
+// ming is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// ming is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with ming.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <ming/versioned_skiplist.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace versioned_skiplist_test {
+
+class VersionedSkipList_TEST : public ::testing::Test {
+protected:
+  void TearDown() override { ming::EpochReclaimer::instance().synchronize(); }
+
+  ming::VersionedSkipList<int, std::string> map;
+};
+
+TEST_F(VersionedSkipList_TEST, SnapshotsSeeTheirVersion) {
+  map.put(1, "one");
+  map.put(2, "two");
+  auto before = map.snapshot();
+
+  map.put(1, "uno");
+  map.erase(2);
+  map.put(3, "three");
+  auto after = map.snapshot();
+
+  EXPECT_EQ(before.find(1), "one");
+  EXPECT_EQ(before.find(2), "two");
+  EXPECT_FALSE(before.contains(3));
+
+  EXPECT_EQ(after.find(1), "uno");
+  EXPECT_FALSE(after.contains(2));
+  EXPECT_EQ(after.find(3), "three");
+  EXPECT_EQ(map.find(1), "uno");
+
+  EXPECT_EQ(before.sequence(), 2u);
+  EXPECT_EQ(after.sequence(), map.sequence());
+  EXPECT_EQ(map.versions(), 5u);
+
+  // a deleted key can come back
+  map.put(2, "dos");
+  EXPECT_EQ(map.find(2), "dos");
+  EXPECT_FALSE(after.contains(2));
+}
+
+TEST_F(VersionedSkipList_TEST, SnapshotIteration) {
+  for (int i = 0; i < 10; ++i) {
+    map.put(i, std::to_string(i));
+  }
+  auto first = map.snapshot();
+  for (int i = 0; i < 10; i += 2) {
+    map.put(i, "even");
+  }
+  map.erase(5);
+
+  std::vector<std::pair<int, std::string>> seen;
+  for (auto [key, value] : first) {
+    seen.emplace_back(key, value);
+  }
+  ASSERT_EQ(seen.size(), 10u);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(seen[i], std::make_pair(i, std::to_string(i)));
+  }
+
+  seen.clear();
+  auto latest = map.snapshot();
+  for (auto it = latest.lower_bound(4); it != latest.end(); ++it) {
+    auto [key, value] = *it;
+    seen.emplace_back(key, value);
+  }
+  EXPECT_EQ(seen, (std::vector<std::pair<int, std::string>>{
+                      {4, "even"}, {6, "even"}, {7, "7"}, {8, "even"}, {9, "9"}}));
+
+  // a snapshot of an earlier sequence number
+  auto old = map.snapshot(3);
+  int count = 0;
+  for (auto it = old.begin(); it != old.end(); ++it) {
+    ++count;
+  }
+  EXPECT_EQ(count, 3);
+}
+
+TEST(VersionedSkipList, ReadersDuringWrites) {
+  constexpr int KEYS = 64;
+  constexpr int ROUNDS = 50;
+  ming::VersionedSkipList<int, int> map;
+  std::atomic<bool> done{false};
+
+  std::thread writer([&] {
+    for (int r = 1; r <= ROUNDS; ++r) {
+      for (int k = 0; k < KEYS; ++k) {
+        map.put(k, r);
+      }
+    }
+    done.store(true);
+  });
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        auto snap = map.snapshot();
+        auto const seq = static_cast<int>(snap.sequence());
+        int expected_keys = std::min(seq, KEYS);
+        int count = 0;
+        for (auto [key, value] : snap) {
+          // write (r, k) has sequence (r - 1) * KEYS + k + 1
+          int expected = (seq - key - 1) / KEYS + 1;
+          ASSERT_EQ(value, expected);
+          ASSERT_EQ(key, count);
+          ++count;
+        }
+        ASSERT_EQ(count, expected_keys);
+      }
+    });
+  }
+
+  writer.join();
+  for (auto &r : readers) {
+    r.join();
+  }
+  EXPECT_EQ(map.find(KEYS - 1), ROUNDS);
+  ming::EpochReclaimer::instance().synchronize();
+}
+
+} // namespace versioned_skiplist_test
@@ -18,7 +18,36 @@
 
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <cstdlib>
+#include <list>
 #include <ming/weighted_lru.hpp>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#if defined(__GNUC__) && !defined(__clang__)
+// The replacements below pair malloc with free, which GCC cannot see once inlined
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// When non-negative, the number of allocations left before one throws
+static long allocations_until_failure = -1;
+
+void *operator new(std::size_t n) {
+  if (allocations_until_failure >= 0 && allocations_until_failure-- == 0) {
+    throw std::bad_alloc();
+  }
+  if (void *p = std::malloc(n == 0 ? 1 : n)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
 
 namespace weighted_lru_test {
 
@@ -200,4 +229,219 @@ TEST(WeightedLRU, CapacityOneCache) {
   EXPECT_EQ(rb.value(), 2);
 }
 
+TEST_F(WeightedLRU_TEST, SizeAndWeight) {
+  EXPECT_TRUE(weighted_lru.empty());
+  weighted_lru.put("a", 1, 3);
+  weighted_lru.put("b", 2, 4);
+  EXPECT_EQ(weighted_lru.size(), 2u);
+  EXPECT_EQ(weighted_lru.weight(), 7);
+  weighted_lru.put("a", 1, 8); // evict b
+  EXPECT_EQ(weighted_lru.size(), 1u);
+  EXPECT_EQ(weighted_lru.weight(), 8);
+  EXPECT_EQ(weighted_lru.capacity(), 10);
+}
+
+TEST(WeightedLRU, MatchesListReference) {
+  // The original list + hash map design, as a reference model
+  struct Reference {
+    int capacity;
+    int weight{0};
+    std::list<std::pair<int, int>> order{}; // (key, size), most recent first
+    std::unordered_map<int, std::pair<int, std::list<std::pair<int, int>>::iterator>>
+        items{};
+
+    bool get(int key, int &value) {
+      auto it = items.find(key);
+      if (it == items.end()) {
+        return false;
+      }
+      order.splice(order.begin(), order, it->second.second);
+      value = it->second.first;
+      return true;
+    }
+
+    void put(int key, int value, int size) {
+      if (auto it = items.find(key); it != items.end()) {
+        weight -= it->second.second->second;
+        order.erase(it->second.second);
+        items.erase(it);
+      }
+      while (weight + size > capacity) {
+        weight -= order.back().second;
+        items.erase(order.back().first);
+        order.pop_back();
+      }
+      order.emplace_front(key, size);
+      items[key] = {value, order.begin()};
+      weight += size;
+    }
+  };
+
+  ming::WeightedLRU<int, int> lru{500};
+  Reference reference{500};
+  std::mt19937 gen(5);
+  for (int i = 0; i < 200000; ++i) {
+    int const key = static_cast<int>(gen() % 300);
+    if (gen() % 2) {
+      int const size = 1 + static_cast<int>(gen() % 20);
+      lru.put(key, i, size);
+      reference.put(key, i, size);
+    } else {
+      int expected = 0;
+      bool const hit = reference.get(key, expected);
+      auto r = lru.get(key);
+      ASSERT_EQ(r.has_value(), hit) << "step " << i;
+      if (hit) {
+        ASSERT_EQ(r.value(), expected);
+      }
+    }
+    ASSERT_EQ(lru.size(), reference.items.size());
+    ASSERT_EQ(lru.weight(), reference.weight);
+  }
+}
+
+TEST(WeightedLRU, GetIfAndStringViewLookup) {
+  ming::WeightedLRU<std::string, std::string> lru{2};
+  std::string const long_key(40, 'k');
+  lru.put(long_key, std::string(4096, 'v'), 1);
+  lru.put("b", "bee", 1);
+
+  // Found through a view of a different buffer, without a temporary string
+  std::string const other = long_key;
+  std::string_view const view = other;
+  std::string const *value = lru.get_if(view);
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(value, &lru.value(lru.find(long_key)));
+  EXPECT_EQ(value->size(), 4096u);
+  EXPECT_EQ(lru.get_if("missing"), nullptr);
+  EXPECT_EQ(lru.get(std::string_view{"b"}).value(), "bee");
+
+  // get_if() records the access: b, not the long key, is evicted
+  EXPECT_NE(lru.get_if(view), nullptr);
+  lru.put("c", "sea", 1);
+  EXPECT_EQ(lru.get_if("b"), nullptr);
+  EXPECT_EQ(*lru.get_if(long_key), std::string(4096, 'v'));
+}
+
+// A clock that only moves when told to
+struct FakeClock {
+  using rep = std::chrono::nanoseconds::rep;
+  using period = std::chrono::nanoseconds::period;
+  using duration = std::chrono::nanoseconds;
+  using time_point = std::chrono::time_point<FakeClock>;
+  static constexpr bool is_steady = true;
+
+  static inline time_point current{std::chrono::hours(1)};
+  static time_point now() noexcept { return current; }
+};
+
+using TimedLRU = ming::WeightedLRU<int, int, ming::LRUPolicy, FakeClock>;
+
+TEST(WeightedLRU, TimeToLive) {
+  using namespace std::chrono_literals;
+  TimedLRU lru{100};
+  lru.put(1, 10, 5, 100ms);
+  lru.put(2, 20, 5);
+  FakeClock::current += 99ms;
+  EXPECT_EQ(lru.get(1).value(), 10);
+  FakeClock::current += 1ms;
+  EXPECT_EQ(lru.find(1), TimedLRU::NOT_CACHED);
+  EXPECT_EQ(lru.weight(), 10);
+  auto r = lru.get(1);
+  ASSERT_FALSE(r.has_value());
+  EXPECT_EQ(r.error(), "No such key!");
+  // The miss reclaimed the expired entry's weight
+  EXPECT_EQ(lru.weight(), 5);
+  EXPECT_EQ(lru.size(), 1u);
+
+  // Putting again without a TTL makes an entry permanent
+  lru.put(3, 30, 5, 10ms);
+  lru.put(3, 31, 5);
+  lru.put(4, 40, 5, std::chrono::nanoseconds::max());
+  lru.put(5, 50, 5, 24h * 400);
+  FakeClock::current += 24h * 399;
+  lru.expire();
+  EXPECT_EQ(lru.get(3).value(), 31);
+  EXPECT_EQ(lru.get(4).value(), 40);
+  EXPECT_EQ(lru.get(5).value(), 50);
+  FakeClock::current += 24h;
+  lru.expire();
+  EXPECT_FALSE(lru.get(5));
+  EXPECT_EQ(lru.get(2).value(), 20);
+}
+
+TEST(WeightedLRU, TimingWheelReclaimsExpiredEntries) {
+  using namespace std::chrono_literals;
+  // Large enough that nothing is evicted, so the cache holds exactly the entries
+  // that have not expired
+  TimedLRU lru{1 << 20};
+  std::unordered_map<int, std::pair<FakeClock::time_point, int>> live;
+  std::mt19937 gen(3);
+  for (int i = 0; i < 20000; ++i) {
+    int const key = static_cast<int>(gen() % 2000);
+    int const size = 1 + static_cast<int>(gen() % 10);
+    if (gen() % 4 == 0) {
+      lru.put(key, i, size);
+      live[key] = {FakeClock::time_point::max(), size};
+    } else {
+      // From 10 ms to over a day, spanning every level of the wheel
+      auto const ttl = 10ms * (1 + static_cast<int>(gen() % 10000)) *
+                       (gen() % 2 ? 1 : 1000);
+      lru.put(key, i, size, ttl);
+      live[key] = {FakeClock::current + ttl, size};
+    }
+    FakeClock::current += 10ms * static_cast<int>(gen() % 200);
+    lru.expire();
+    std::erase_if(live, [](auto const &kv) {
+      return kv.second.first <= FakeClock::current;
+    });
+    int weight = 0;
+    for (auto const &[k, entry] : live) {
+      weight += entry.second;
+    }
+    ASSERT_EQ(lru.size(), live.size()) << "step " << i;
+    ASSERT_EQ(lru.weight(), weight) << "step " << i;
+  }
+}
+
+template <typename Policy>
+static void fail_every_allocation_of_put() {
+  ming::WeightedLRU<int, std::string, Policy> cache(64);
+  for (int key = 0; key < 300; ++key) {
+    // Fail the first, then the second, ... allocation of this put until it succeeds
+    for (long n = 0;; ++n) {
+      allocations_until_failure = n;
+      try {
+        if (key % 3 == 0) {
+          cache.put(key, std::string(40, 'v'), 1 + key % 4, std::chrono::hours(1));
+        } else {
+          cache.put(key % 100, std::string(40, 'v'), 1 + key % 4);
+        }
+        allocations_until_failure = -1;
+        break;
+      } catch (std::bad_alloc const &) {
+        allocations_until_failure = -1;
+      }
+      std::size_t cached = 0;
+      for (int k = 0; k <= key; ++k) {
+        cached += cache.find(k) != decltype(cache)::NOT_CACHED;
+      }
+      ASSERT_EQ(cached, cache.size()) << "key " << key << ", allocation " << n;
+      ASSERT_LE(cache.weight(), cache.capacity());
+    }
+  }
+  // Every entry is still reachable by eviction
+  for (int key = 1000; key < 1100; ++key) {
+    cache.put(key, "v", 4);
+  }
+  EXPECT_EQ(cache.size(), 16u);
+}
+
+TEST(WeightedLRU, StaysConsistentWhenAllocationFails) {
+  fail_every_allocation_of_put<ming::LRUPolicy>();
+  fail_every_allocation_of_put<ming::ARCPolicy>();
+  fail_every_allocation_of_put<ming::S3FIFOPolicy>();
+  fail_every_allocation_of_put<ming::GDSFPolicy>();
+}
+
 } // namespace weighted_lru_test